@@ -0,0 +1,208 @@
+#ifndef PARSE_BATCH_HPP
+#define PARSE_BATCH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+
+// Parser por lotes de ficheros de números separados por '\n'. Los límites de registro se
+// localizan con máscaras de 64 bytes (SSE2 cuando está disponible) y cada línea limpia
+// (solo dígitos) se convierte sin pasar por skip_whitespace.
+
+// Error de una línea concreta del lote (línea contada desde 0). `offset` es el byte
+// donde se detuvo el análisis, contado desde el inicio del buffer.
+struct LineError {
+    std::uint64_t line;
+    ParseError error;
+    std::uint64_t offset;
+};
+
+struct BatchParseResult {
+    std::size_t values;  // Líneas procesadas (valores escritos en la salida)
+    const char* end;     // Primer byte no procesado: last, o el inicio de la línea que no cupo
+};
+
+// Índice del bit menos significativo a 1 de una máscara de 64 bits (mask != 0)
+inline int count_trailing_zeros64(std::uint64_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<unsigned long>(mask))) {
+        return static_cast<int>(index);
+    }
+    _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+    return static_cast<int>(index) + 32;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Máscara de los bytes iguales a `c` en [p, p + count), count <= 64
+inline std::uint64_t char_mask_tail(const char* const p, std::size_t count, char c) noexcept {
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        mask |= static_cast<std::uint64_t>(p[i] == c) << i;
+    }
+    return mask;
+}
+
+// Máscara de los bytes iguales a `c` en el bloque [p, p + 64)
+inline std::uint64_t char_mask64(const char* const p, char c) noexcept {
+#if XPERIMENT_SSE2
+    const __m128i target = _mm_set1_epi8(c);
+    const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+    const std::uint64_t m0 = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v + 0), target)));
+    const std::uint64_t m1 = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v + 1), target)));
+    const std::uint64_t m2 = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v + 2), target)));
+    const std::uint64_t m3 = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v + 3), target)));
+    return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+#else
+    return char_mask_tail(p, 64, c);
+#endif
+}
+
+// Número de registros (líneas) del buffer; la última línea puede no terminar en '\n'
+inline std::size_t count_lines(const char* const first, const char* const last) noexcept {
+    std::size_t lines = 0;
+    const char* block = first;
+    for (; last - block >= 64; block += 64) {
+        std::uint64_t mask = char_mask64(block, '\n');
+        while (mask != 0) {
+            mask &= mask - 1;
+            lines++;
+        }
+    }
+    std::uint64_t mask = char_mask_tail(block, static_cast<std::size_t>(last - block), '\n');
+    while (mask != 0) {
+        mask &= mask - 1;
+        lines++;
+    }
+    if (first != last && last[-1] != '\n') {
+        lines++;
+    }
+    return lines;
+}
+
+// Convierte una línea [first, last) sin el '\n'. Camino rápido: la línea es un número
+// sin blancos (como mucho con un '\r' final); el número se analiza contra el final del
+// buffer para que las cargas de 8 bytes no se corten en cada línea corta.
+inline void parse_number_line(const char* const first, const char* last, const char* const buffer_first,
+                              const char* const buffer_last, std::uint64_t line, std::uint64_t& slot,
+                              std::vector<LineError>& errors) {
+    if (last != first && last[-1] == '\r') {
+        last--;
+    }
+
+    const char* end = first;
+    const Expected<std::uint64_t, ParseError> value = parse_number_simple(first, buffer_last, end);
+    if (value && end == last) {
+        slot = *value;
+        return;
+    }
+
+    const Expected<std::uint64_t, ParseFailure> field = parse_number_field_located(first, last);
+    if (field) {
+        slot = *field;
+    } else {
+        slot = 0;
+        const ParseFailure failure = field.error().rebased(static_cast<std::uint64_t>(first - buffer_first));
+        errors.push_back(LineError{line, failure.code(), failure.offset()});
+    }
+}
+
+// Convierte todas las líneas de [first, last) escribiendo un valor por línea en `out`
+// (0 en las líneas con error). Los errores se añaden a `errors` como (línea, ParseError,
+// byte desde `first`);
+// `first_line` es el número de la primera línea, útil al procesar un fichero por trozos.
+// Si la salida se llena antes del final, `end` indica dónde continuar.
+inline BatchParseResult parse_number_lines(const char* const first, const char* const last,
+                                           std::uint64_t* const out, std::size_t capacity,
+                                           std::vector<LineError>& errors, std::uint64_t first_line = 0) {
+    std::size_t count = 0;
+    const char* line = first;
+
+    for (const char* block = first; block < last; block += 64) {
+        const std::size_t available = static_cast<std::size_t>(last - block);
+        std::uint64_t mask = available >= 64 ? char_mask64(block, '\n') : char_mask_tail(block, available, '\n');
+        while (mask != 0) {
+            if (count == capacity) {
+                return BatchParseResult{count, line};
+            }
+            const char* const newline = block + count_trailing_zeros64(mask);
+            mask &= mask - 1;
+            parse_number_line(line, newline, first, last, first_line + count, out[count], errors);
+            count++;
+            line = newline + 1;
+        }
+    }
+
+    if (line != last) {
+        if (count == capacity) {
+            return BatchParseResult{count, line};
+        }
+        parse_number_line(line, last, first, last, first_line + count, out[count], errors);
+        count++;
+    }
+    return BatchParseResult{count, last};
+}
+
+// Igual que parse_number_line para literales de dígito: dígito y base por separado
+inline void parse_digit_line(const char* const first, const char* last, const char* const buffer_first, std::uint64_t line,
+                             std::uint64_t& digit_slot, std::uint64_t& base_slot, std::vector<LineError>& errors) {
+    if (last != first && last[-1] == '\r') {
+        last--;
+    }
+
+    const Expected<DigitResult, ParseFailure> literal = parse_digit_format_field_located(first, last);
+    if (literal) {
+        digit_slot = literal->digit;
+        base_slot = literal->base;
+    } else {
+        digit_slot = 0;
+        base_slot = 0;
+        const ParseFailure failure = literal.error().rebased(static_cast<std::uint64_t>(first - buffer_first));
+        errors.push_back(LineError{line, failure.code(), failure.offset()});
+    }
+}
+
+// Versión de parse_number_lines para ficheros de literales "d#N#BM" / "dig[N]BM", uno por
+// línea. Dígitos y bases se escriben en dos arrays paralelos (0 en las líneas con error).
+inline BatchParseResult parse_digit_lines(const char* const first, const char* const last,
+                                          std::uint64_t* const digits, std::uint64_t* const bases,
+                                          std::size_t capacity, std::vector<LineError>& errors,
+                                          std::uint64_t first_line = 0) {
+    std::size_t count = 0;
+    const char* line = first;
+
+    for (const char* block = first; block < last; block += 64) {
+        const std::size_t available = static_cast<std::size_t>(last - block);
+        std::uint64_t mask = available >= 64 ? char_mask64(block, '\n') : char_mask_tail(block, available, '\n');
+        while (mask != 0) {
+            if (count == capacity) {
+                return BatchParseResult{count, line};
+            }
+            const char* const newline = block + count_trailing_zeros64(mask);
+            mask &= mask - 1;
+            parse_digit_line(line, newline, first, first_line + count, digits[count], bases[count], errors);
+            count++;
+            line = newline + 1;
+        }
+    }
+
+    if (line != last) {
+        if (count == capacity) {
+            return BatchParseResult{count, line};
+        }
+        parse_digit_line(line, last, first, first_line + count, digits[count], bases[count], errors);
+        count++;
+    }
+    return BatchParseResult{count, last};
+}
+
+#endif // PARSE_BATCH_HPP
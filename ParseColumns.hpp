@@ -0,0 +1,164 @@
+#ifndef PARSE_COLUMNS_HPP
+#define PARSE_COLUMNS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+
+// Parser de filas CSV/TSV a columnas separadas (struct-of-arrays). Cada columna escribe
+// en su propio array contiguo, una posición por fila, y marca en un bitmap las filas
+// en las que su campo no es válido. Los campos se analizan en el buffer de entrada, sin
+// copias ni reservas de memoria.
+//
+// Los límites de campo y de fila salen de una única máscara por bloque de 64 bytes
+// (delimitador | '\n'), igual que en parse_number_lines. No hay comillas: los campos
+// son números o literales de dígito. La última columna se queda con el resto de la
+// línea, así que un delimitador de más la invalida; las columnas que faltan en una fila
+// se marcan como erróneas. Un '\r' final (CRLF) se ignora.
+
+enum class ColumnType {
+    Number,        // parse_number_field -> values
+    DigitLiteral,  // parse_digit_format_field -> values (dígito) y bases
+    Skip           // Columna ignorada: no escribe nada
+};
+
+// Salida de una columna. values y bases tienen sitio para `capacity` filas y errors
+// para error_bitmap_words(capacity) palabras. En las filas con error el valor es 0.
+struct Column {
+    ColumnType type;
+    std::uint64_t* values;  // Number: valor; DigitLiteral: dígito
+    std::uint64_t* bases;   // Solo DigitLiteral
+    std::uint64_t* errors;  // Fila r con error <=> bit r % 64 de errors[r / 64]
+};
+
+constexpr std::size_t error_bitmap_words(std::size_t rows) noexcept {
+    return (rows + 63) / 64;
+}
+
+inline bool column_has_error(const Column& column, std::size_t row) noexcept {
+    return ((column.errors[row / 64] >> (row % 64)) & 1u) != 0;
+}
+
+inline void mark_column_error(const Column& column, std::size_t row) noexcept {
+    column.errors[row / 64] |= std::uint64_t(1) << (row % 64);
+}
+
+// Convierte el campo [first, last) de la fila `row`. buffer_last permite el camino
+// rápido de parse_number_line: número sin blancos analizado contra el final del buffer.
+inline void parse_column_field(const Column& column, std::size_t row, const char* const first, const char* const last,
+                               const char* const buffer_last) noexcept {
+    switch (column.type) {
+    case ColumnType::Number: {
+        const char* end = first;
+        const Expected<std::uint64_t, ParseError> value = parse_number_simple(first, buffer_last, end);
+        if (value && end == last) {
+            column.values[row] = *value;
+            return;
+        }
+        const Expected<std::uint64_t, ParseError> field = parse_number_field(first, last);
+        column.values[row] = field ? *field : 0;
+        if (!field) {
+            mark_column_error(column, row);
+        }
+        return;
+    }
+    case ColumnType::DigitLiteral: {
+        const Expected<DigitResult, ParseError> literal = parse_digit_format_field(first, last);
+        column.values[row] = literal ? literal->digit : 0;
+        column.bases[row] = literal ? literal->base : 0;
+        if (!literal) {
+            mark_column_error(column, row);
+        }
+        return;
+    }
+    case ColumnType::Skip:
+        return;
+    }
+}
+
+// Columna sin campo en la fila: valor 0 y error
+inline void mark_missing_field(const Column& column, std::size_t row) noexcept {
+    if (column.type == ColumnType::Skip) {
+        return;
+    }
+    column.values[row] = 0;
+    if (column.type == ColumnType::DigitLiteral) {
+        column.bases[row] = 0;
+    }
+    mark_column_error(column, row);
+}
+
+// Parsea las filas de [first, last) en `columns` (column_count > 0) hasta `capacity`
+// filas. Las palabras del bitmap se inicializan aquí, al empezar cada grupo de 64 filas.
+// Si la salida se llena antes del final, `end` indica dónde continuar; para seguir con
+// otra llamada, las filas nuevas empiezan en la posición 0 de cada array.
+inline BatchParseResult parse_delimited_rows(const char* const first, const char* const last, char delimiter,
+                                             const Column* const columns, std::size_t column_count, std::size_t capacity) noexcept {
+    if (capacity == 0 || first == last) {
+        return BatchParseResult{0, first};
+    }
+
+    std::size_t row = 0;
+    std::size_t column = 0;
+    const char* field = first;
+
+    const auto start_row = [&] {
+        if (row % 64 == 0) {
+            for (std::size_t c = 0; c < column_count; ++c) {
+                if (columns[c].type != ColumnType::Skip) {
+                    columns[c].errors[row / 64] = 0;
+                }
+            }
+        }
+    };
+    // Último campo de la fila (sin '\r' final) y columnas que faltan
+    const auto finish_row = [&](const char* line_end) {
+        if (line_end != field && line_end[-1] == '\r') {
+            line_end--;
+        }
+        parse_column_field(columns[column], row, field, line_end, last);
+        for (std::size_t c = column + 1; c < column_count; ++c) {
+            mark_missing_field(columns[c], row);
+        }
+        row++;
+        column = 0;
+    };
+
+    start_row();
+    for (const char* block = first; block < last; block += 64) {
+        const std::size_t available = static_cast<std::size_t>(last - block);
+        std::uint64_t mask = available >= 64
+            ? char_mask64(block, '\n') | char_mask64(block, delimiter)
+            : char_mask_tail(block, available, '\n') | char_mask_tail(block, available, delimiter);
+        while (mask != 0) {
+            const char* const boundary = block + count_trailing_zeros64(mask);
+            mask &= mask - 1;
+            if (*boundary != '\n') {
+                // Delimitador: cierra el campo salvo en la última columna
+                if (column + 1 < column_count) {
+                    parse_column_field(columns[column], row, field, boundary, last);
+                    column++;
+                    field = boundary + 1;
+                }
+                continue;
+            }
+            finish_row(boundary);
+            field = boundary + 1;
+            if (row == capacity) {
+                return BatchParseResult{row, field};
+            }
+            start_row();
+        }
+    }
+
+    // Última fila sin '\n' (puede acabar en delimitador, con el campo final vacío)
+    if (field != last || column != 0) {
+        finish_row(last);
+    }
+    return BatchParseResult{row, last};
+}
+
+#endif // PARSE_COLUMNS_HPP
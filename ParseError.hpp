@@ -1,3 +1,6 @@
+#ifndef PARSE_ERROR_HPP
+#define PARSE_ERROR_HPP
+
 #include <cstdint>
 #include <iostream>
 #include <type_traits>
@@ -20,65 +23,536 @@ enum class ParseError {
     EmptyBase,              // Base vacía
     BlankInterDigitsOfBase, // Espacios en blanco entre dígitos de la base
     BaseOutOfRange,         // base-1 > uint32_max
+    InvalidMantissa,        // Mantisa de coma flotante sin dígitos ("-", ".", "-.e5")
+    InvalidExponent,        // Exponente sin dígitos tras "e" / "e+" / "e-"
+    MisplacedSeparator,     // Separador de grupos al principio, al final o repetido ("_1", "1_", "1__0")
     UnknownError            // Error desconocido
 };
 
+// Error con posición: el código y el desplazamiento en bytes, desde el inicio de la
+// entrada, del punto donde se detuvo el análisis. Van empaquetados en una palabra de 64
+// bits (código en el byte bajo, desplazamiento en los 56 altos), así que
+// Expected<std::uint64_t, ParseFailure> ocupa lo mismo que con ParseError. Solo se
+// construye en el camino de error: los aciertos no pagan nada por la posición.
+class ParseFailure {
+public:
+    static constexpr std::uint64_t max_offset = (std::uint64_t(1) << 56) - 1;  // Satura en 64 PiB
+
+    constexpr ParseFailure() noexcept : bits_(static_cast<std::uint8_t>(ParseError::UnknownError)) {}
+    constexpr ParseFailure(ParseError code, std::uint64_t offset) noexcept
+        : bits_(((offset < max_offset ? offset : max_offset) << 8) | static_cast<std::uint8_t>(code)) {}
+
+    constexpr ParseError code() const noexcept { return static_cast<ParseError>(bits_ & 0xFF); }
+    constexpr std::uint64_t offset() const noexcept { return bits_ >> 8; }
+
+    // El mismo fallo contado desde una entrada que empieza `base` bytes antes
+    constexpr ParseFailure rebased(std::uint64_t base) const noexcept { return ParseFailure(code(), offset() + base); }
+
+    constexpr bool operator==(const ParseFailure& other) const noexcept { return bits_ == other.bits_; }
+    constexpr bool operator!=(const ParseFailure& other) const noexcept { return bits_ != other.bits_; }
+
+private:
+    std::uint64_t bits_;
+};
+
+// Añade la posición a un resultado con ParseError; `offset` solo se usa si hay error
+template<typename T>
+constexpr Expected<T, ParseFailure> locate_failure(const Expected<T, ParseError>& result, std::uint64_t offset) noexcept {
+    if (!result) {
+        return make_unexpected(ParseFailure(result.error(), offset));
+    }
+    return Expected<T, ParseFailure>(*result);
+}
+
+
+// --- Plataforma ---
+
+// SSE2 forma parte de la base de x86-64: se usa sin comprobar cpuid
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XPERIMENT_SSE2 1
+#include <emmintrin.h>
+#else
+#define XPERIMENT_SSE2 0
+#endif
+
+// Las cargas vectoriales sobre cadenas terminadas en '\0' pueden leer más allá del
+// terminador (sin salir de la página); ASan lo marcaría como desbordamiento
+#if defined(__GNUC__) || defined(__clang__)
+#define XPERIMENT_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define XPERIMENT_NO_ASAN
+#endif
+
+// ¿Se está evaluando en tiempo de compilación? Permite que una función constexpr tome un
+// camino SIMD en ejecución. Sin soporte del compilador se usa siempre el camino constexpr.
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define XPERIMENT_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#define XPERIMENT_RUNTIME_SIMD XPERIMENT_SSE2
+#else
+#define XPERIMENT_IS_CONSTANT_EVALUATED() true
+#define XPERIMENT_RUNTIME_SIMD 0
+#endif
+
+// --- Clases de carácter ---
+
+enum CharClass : unsigned char {
+    char_class_whitespace = 1,  // ' ', '\t', '\n', '\r'
+    char_class_digit = 2        // '0'..'9'
+};
+
+struct CharClassTable {
+    unsigned char classes[256];
+};
+
+constexpr CharClassTable make_char_class_table() noexcept {
+    CharClassTable table{};
+    for (int c = 0; c < 256; ++c) {
+        table.classes[c] = static_cast<unsigned char>(
+            ((c == ' ' || c == '\t' || c == '\n' || c == '\r') ? char_class_whitespace : 0) |
+            ((c >= '0' && c <= '9') ? char_class_digit : 0));
+    }
+    return table;
+}
+
+// Miembro estático de una plantilla: una sola copia en todo el programa aunque la
+// cabecera se incluya en varias unidades de traducción (C++14 no tiene variables inline)
+template<typename Unused = void>
+struct CharClasses {
+    static constexpr CharClassTable table = make_char_class_table();
+};
 
-// Helper para skippear blancos
+template<typename Unused>
+constexpr CharClassTable CharClasses<Unused>::table;
+
+// Una carga y un test en lugar de cuatro comparaciones
+constexpr bool is_whitespace(char c) noexcept {
+    return (CharClasses<>::table.classes[static_cast<unsigned char>(c)] & char_class_whitespace) != 0;
+}
+
+// --- Salto de blancos ---
+
+#if XPERIMENT_RUNTIME_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Índice del bit menos significativo a 1 (mask != 0)
+inline int lowest_set_bit(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Máscara de los blancos en los 16 bytes de `v`
+inline std::uint32_t whitespace_mask16(__m128i v) noexcept {
+    const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+    const __m128i newline = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(blank, newline)));
+}
+
+// Máscara de los dígitos ASCII en los 16 bytes de `v` (los bytes >= 0x80 son negativos
+// en la comparación con signo y quedan fuera)
+inline std::uint32_t digit_mask16(__m128i v) noexcept {
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(digit));
+}
+
+// Máscara de los bytes iguales a `c` en los 32 bytes low | high
+inline std::uint32_t byte_mask32(__m128i low, __m128i high, char c) noexcept {
+    const __m128i target = _mm_set1_epi8(c);
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(low, target))) |
+           (static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(high, target))) << 16);
+}
+
+// Máscara de los blancos en los 32 bytes a partir de p
+XPERIMENT_NO_ASAN
+inline std::uint32_t whitespace_mask32(const char* const p) noexcept {
+    const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+    return whitespace_mask16(_mm_loadu_si128(v)) | (whitespace_mask16(_mm_loadu_si128(v + 1)) << 16);
+}
+
+// Salta blancos de 32 en 32 bytes mientras queden 32 en el rango; el resto lo hace el
+// bucle escalar del llamador
+inline const char* skip_whitespace_simd(const char* p, const char* const last) noexcept {
+    while (last - p >= 32) {
+        const std::uint32_t mask = whitespace_mask32(p);
+        if (mask != 0xFFFFFFFFu) {
+            return p + lowest_set_bit(~mask);
+        }
+        p += 32;
+    }
+    return p;
+}
+
+// Versión para cadenas terminadas en '\0': los bloques de 32 bytes solo se cargan si no
+// cruzan de página (como strlen). El '\0' no es blanco, así que detiene el salto.
+XPERIMENT_NO_ASAN
+inline const char* skip_whitespace_simd(const char* p) noexcept {
+    while ((reinterpret_cast<std::uintptr_t>(p) & 4095u) <= 4096u - 32) {
+        const std::uint32_t mask = whitespace_mask32(p);
+        if (mask != 0xFFFFFFFFu) {
+            return p + lowest_set_bit(~mask);
+        }
+        p += 32;
+    }
+    return p;
+}
+
+#endif // XPERIMENT_RUNTIME_SIMD
+
+// Helper para skippear blancos. En ejecución, a partir del segundo blanco seguido se
+// salta de 32 en 32 bytes; en compilación (static_assert) se usa solo la tabla.
 constexpr int skip_whitespace(const char* str, int index) noexcept {
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && is_whitespace(str[index]) && is_whitespace(str[index + 1])) {
+        index = static_cast<int>(skip_whitespace_simd(str + index) - str);
+    }
+#endif
+    while (is_whitespace(str[index])) {
         index++;
     }
     return index;
 }
 
+// Helper para skippear blancos en un rango acotado [first, last)
+constexpr const char* skip_whitespace(const char* first, const char* const last) noexcept {
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && last - first >= 2 && is_whitespace(first[0]) && is_whitespace(first[1])) {
+        first = skip_whitespace_simd(first, last);
+    }
+#endif
+    while (first != last && is_whitespace(*first)) {
+        first++;
+    }
+    return first;
+}
+
+// --- Núcleo SWAR (SIMD dentro de un registro) ---
+
+// Número máximo de dígitos significativos de un uint64_t ("18446744073709551615")
+constexpr int max_uint64_digits = 20;
+
+// Carga 8 caracteres en un uint64_t con el primero en el byte bajo.
+// GCC/Clang reconocen el patrón y lo reducen a una única carga; sigue siendo constexpr.
+constexpr std::uint64_t swar_load8(const char* const p) noexcept {
+    return static_cast<std::uint64_t>(static_cast<unsigned char>(p[0]))
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[1])) << 8
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[2])) << 16
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[3])) << 24
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[4])) << 32
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[5])) << 40
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[6])) << 48
+         | static_cast<std::uint64_t>(static_cast<unsigned char>(p[7])) << 56;
+}
+
+// Convierte 8 dígitos ASCII ya validados con la técnica multiplica-y-desplaza:
+// pares de dígitos, luego grupos de 4 y finalmente los 8, sin bucle ni divisiones.
+constexpr std::uint32_t swar_parse_eight_digits(std::uint64_t word) noexcept {
+    word = ((word & 0x0F0F0F0F0F0F0F0FULL) * 2561ULL) >> 8;                 // 10 * 2^8 + 1
+    word = ((word & 0x00FF00FF00FF00FFULL) * 6553601ULL) >> 16;             // 100 * 2^16 + 1
+    return static_cast<std::uint32_t>(
+        ((word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);        // 10000 * 2^32 + 1
+}
+
+// Comprueba con una sola comparación que los 8 bytes de la palabra son dígitos ASCII:
+// el nibble alto debe ser 3 y al sumar 6 al nibble bajo no debe haber acarreo
+constexpr bool swar_is_eight_digits(std::uint64_t word) noexcept {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+// Número de bytes anteriores al primer byte marcado (bit alto a 1) de `flags`; 8 si no
+// hay ninguno. Los bits por debajo de la marca se cuentan por bytes con una multiplicación.
+constexpr int swar_leading_clear_bytes(std::uint64_t flags) noexcept {
+    if (flags == 0) {
+        return 8;
+    }
+    const std::uint64_t below = (flags & (~flags + 1)) - 1;
+    return static_cast<int>(((below & 0x0101010101010101ULL) * 0x0101010101010101ULL) >> 56) - 1;
+}
+
+// Número de dígitos ASCII consecutivos al principio de la palabra (0..8), sin bucles.
+// El byte más bajo que no es dígito tiene su bit alto activo en (w - '0') | (w + 0x46);
+// los acarreos entre bytes solo afectan a los bytes posteriores a él.
+constexpr int swar_digit_count(std::uint64_t word) noexcept {
+    return swar_leading_clear_bytes(
+        ((word - 0x3030303030303030ULL) | (word + 0x4646464646464646ULL)) & 0x8080808080808080ULL);
+}
+
+// 10^n para 0 <= n <= 19
+constexpr std::uint64_t power_of_ten(int n) noexcept {
+    constexpr std::uint64_t powers[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+        100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL,
+        10000000000000ULL, 100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+    };
+    return powers[n];
+}
+
+// Comprueba si 20 dígitos significativos caben en un uint64_t comparándolos con el máximo
+constexpr bool fits_uint64_20_digits(const char* const p) noexcept {
+    const char* const max_uint64_str = "18446744073709551615";
+    for (int i = 0; i < max_uint64_digits; ++i) {
+        if (p[i] != max_uint64_str[i]) {
+            return p[i] < max_uint64_str[i];
+        }
+    }
+    return true;
+}
+
+// Acumula `count` dígitos ya validados que se sabe que caben en un uint64_t.
+// Bloques de 8 por SWAR y el resto (como mucho 7) dígito a dígito.
+constexpr std::uint64_t accumulate_digits(const char* p, int count) noexcept {
+    std::uint64_t result = 0;
+    while (count >= 8) {
+        result = result * 100000000ULL + swar_parse_eight_digits(swar_load8(p));
+        p += 8;
+        count -= 8;
+    }
+    while (count > 0) {
+        result = result * 10 + static_cast<std::uint64_t>(*p - '0');
+        p++;
+        count--;
+    }
+    return result;
+}
+
 // Parser de número sin blancos intermedios - versión simplificada para C++14
+// Primero se mide la racha de dígitos y después se convierte en bloques de 8; el
+// overflow se decide una sola vez por número de dígitos significativos. En caso de
+// overflow end_index señala el mismo dígito que señalaba el bucle dígito a dígito.
 constexpr Expected<std::uint64_t, ParseError> parse_number_simple(const char* const str, int start_index, int& end_index) noexcept {
     if (str[start_index] < '0' || str[start_index] > '9') {
         end_index = start_index;
         return make_unexpected(ParseError::InvalidCharacter);
     }
 
-    std::uint64_t result = 0;
-    int index = start_index;
-    bool found_digit = false;
-
-    while (str[index] != '\0' && str[index] >= '0' && str[index] <= '9') {
-        found_digit = true;
-        std::uint64_t digit = str[index] - '0';
-
-        // Verificar overflow
-        const std::uint64_t max_uint64 = 18446744073709551615ULL;
-        if (result > max_uint64 / 10) {
-            end_index = index;
-            return make_unexpected(ParseError::Overflow);
-        }
+    // Los ceros a la izquierda no cuentan para el límite de 20 dígitos
+    int first_significant = start_index;
+    while (str[first_significant] == '0') {
+        first_significant++;
+    }
+
+    int index = first_significant;
+    while (str[index] >= '0' && str[index] <= '9') {
+        index++;
+    }
 
-        result *= 10;
+    const int significant = index - first_significant;
+    if (significant > max_uint64_digits ||
+        (significant == max_uint64_digits && !fits_uint64_20_digits(str + first_significant))) {
+        // El bucle original fallaba en el dígito 20 si esos 20 ya desbordaban, o en el 21
+        end_index = first_significant + (fits_uint64_20_digits(str + first_significant) ? 20 : 19);
+        return make_unexpected(ParseError::Overflow);
+    }
 
-        if (result > max_uint64 - digit) {
-            end_index = index;
-            return make_unexpected(ParseError::Overflow);
+    end_index = index;
+    return Expected<std::uint64_t, ParseError>(accumulate_digits(str + first_significant, significant));
+}
+
+// Versión acotada al estilo std::from_chars: trabaja sobre [first, last) sin buscar '\0'
+// y deja en `end` el primer carácter no consumido (o el dígito del overflow, como arriba).
+// Mientras quedan 8 bytes en el rango, los números de hasta 16 dígitos se miden y
+// convierten por bloques de 8 sin ningún bucle por dígito.
+constexpr Expected<std::uint64_t, ParseError> parse_number_simple(const char* const first, const char* const last, const char*& end) noexcept {
+    if (first == last || *first < '0' || *first > '9') {
+        end = first;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    const char* significant = first;
+    while (significant != last && *significant == '0') {
+        significant++;
+    }
+
+    const char* p = significant;
+    std::uint64_t value = 0;
+    for (int block = 0; block < 2 && last - p >= 8; ++block) {
+        const std::uint64_t word = swar_load8(p);
+        const int digits = swar_digit_count(word);
+        if (digits < 8) {
+            // Los bytes desplazados a la izquierda valen 0, como ceros a la izquierda
+            if (digits != 0) {
+                value = value * power_of_ten(digits) + swar_parse_eight_digits(word << (8 * (8 - digits)));
+            }
+            end = p + digits;
+            return Expected<std::uint64_t, ParseError>(value);
         }
+        value = value * 100000000ULL + swar_parse_eight_digits(word);
+        p += 8;
+    }
 
-        result += digit;
-        index++;
+    // Números largos o final del rango cercano: se mide el resto y se decide el overflow
+    const char* const converted = p;
+    while (last - p >= 8 && swar_is_eight_digits(swar_load8(p))) {
+        p += 8;
+    }
+    while (p != last && *p >= '0' && *p <= '9') {
+        p++;
     }
 
-    end_index = index;
-    if (!found_digit) {
-        return make_unexpected(ParseError::Empty);
+    const int count = static_cast<int>(p - significant);
+    if (count > max_uint64_digits ||
+        (count == max_uint64_digits && !fits_uint64_20_digits(significant))) {
+        end = significant + (fits_uint64_20_digits(significant) ? 20 : 19);
+        return make_unexpected(ParseError::Overflow);
     }
 
-    return Expected<std::uint64_t, ParseError>(result);
+    const int remaining = static_cast<int>(p - converted);
+    end = p;
+    return Expected<std::uint64_t, ParseError>(value * power_of_ten(remaining) + accumulate_digits(converted, remaining));
 }
 
-// Versión simplificada del parser de formato de dígito para MSVC C++14
-constexpr Expected<DigitResult, ParseError> parse_digit_format_simple(const char* const str) noexcept {
+// parse_number_simple con la posición del error: end_index desde el inicio de `str`
+constexpr Expected<std::uint64_t, ParseFailure> parse_number_located(const char* const str, int start_index, int& end_index) noexcept {
+    return locate_failure(parse_number_simple(str, start_index, end_index), static_cast<std::uint64_t>(end_index));
+}
+
+// Frente común de los parsers de campo completo en [first, last): admite blancos alrededor
+// del valor pero no dentro ("12 34" -> BlankInterDigits) ni otros caracteres detrás
+// ("12a" -> InvalidCharacter). Parser aporta parse(first, last, end), que convierte el
+// valor y deja en `end` el primer carácter no consumido, e is_digit(c).
+// El error lleva su desplazamiento desde first: el carácter que lo provoca, o el final
+// del campo si está vacío.
+template<typename T, typename Parser>
+constexpr Expected<T, ParseFailure> parse_field_located(const char* const first, const char* const last) {
+    const char* p = skip_whitespace(first, last);
+    if (p == last) {
+        return make_unexpected(ParseFailure(ParseError::Empty, static_cast<std::uint64_t>(last - first)));
+    }
+
+    const char* end = p;
+    const Expected<T, ParseError> value = Parser::parse(p, last, end);
+    if (!value) {
+        return make_unexpected(ParseFailure(value.error(), static_cast<std::uint64_t>(end - first)));
+    }
+
+    const char* rest = skip_whitespace(end, last);
+    if (rest == last) {
+        return Expected<T, ParseFailure>(*value);
+    }
+    const ParseError error = (rest != end && Parser::is_digit(*rest)) ? ParseError::BlankInterDigits : ParseError::InvalidCharacter;
+    return make_unexpected(ParseFailure(error, static_cast<std::uint64_t>(rest - first)));
+}
+
+// Igual, sin la posición
+template<typename T, typename Parser>
+constexpr Expected<T, ParseError> parse_field(const char* const first, const char* const last) {
+    const Expected<T, ParseFailure> value = parse_field_located<T, Parser>(first, last);
+    if (!value) {
+        return make_unexpected(value.error().code());
+    }
+    return Expected<T, ParseError>(*value);
+}
+
+struct DecimalFieldParser {
+    static constexpr Expected<std::uint64_t, ParseError> parse(const char* first, const char* last, const char*& end) noexcept {
+        return parse_number_simple(first, last, end);
+    }
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+};
+
+// Campo numérico completo en [first, last)
+constexpr Expected<std::uint64_t, ParseError> parse_number_field(const char* const first, const char* const last) noexcept {
+    return parse_field<std::uint64_t, DecimalFieldParser>(first, last);
+}
+
+constexpr Expected<std::uint64_t, ParseFailure> parse_number_field_located(const char* const first, const char* const last) noexcept {
+    return parse_field_located<std::uint64_t, DecimalFieldParser>(first, last);
+}
+
+// --- Camino rápido de la forma canónica ---
+
+#if XPERIMENT_RUNTIME_SIMD
+
+struct CanonicalDigit {
+    std::uint64_t digit;
+    std::uint64_t base;
+    int end;  // Posición tras el último dígito de la base
+};
+
+// Convierte `count` (1..19) dígitos de p; p tiene al menos 8 bytes legibles tras el
+// último dígito, así que el bloque final de menos de 8 se convierte desplazado
+inline std::uint64_t convert_short_digits(const char* p, int count) noexcept {
+    std::uint64_t value = 0;
+    while (count >= 8) {
+        value = value * 100000000ULL + swar_parse_eight_digits(swar_load8(p));
+        p += 8;
+        count -= 8;
+    }
+    if (count != 0) {
+        value = value * power_of_ten(count) + swar_parse_eight_digits(swar_load8(p) << (8 * (8 - count)));
+    }
+    return value;
+}
+
+// Especulación sobre la forma canónica "d#N#BM" sin blancos, con N de hasta 19 dígitos y M
+// de hasta 10, en los 32 bytes a partir de p: "d#" con una comparación de 16 bits y el
+// resto con máscaras de dígitos, '#' y 'B' y dos ctz. in_range marca los bytes que
+// pertenecen al literal; con nul_terminated la base debe ir seguida de '\0'. Puede leer
+// 32 bytes, así que el llamador garantiza que no se cruza de página. false si la forma
+// no es canónica: el llamador sigue entonces con la gramática completa.
+XPERIMENT_NO_ASAN
+inline bool parse_digit_canonical(const char* const p, std::uint32_t in_range, bool nul_terminated, CanonicalDigit& out) noexcept {
+    const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+    const __m128i low = _mm_loadu_si128(v);
+    const __m128i high = _mm_loadu_si128(v + 1);
+    if ((static_cast<std::uint32_t>(_mm_cvtsi128_si32(low)) & 0xFFFFu) != ('d' | ('#' << 8)) || (in_range & 2u) == 0) {
+        return false;
+    }
+    const std::uint32_t digits = (digit_mask16(low) | (digit_mask16(high) << 16)) & in_range;
+    const std::uint32_t hashes = byte_mask32(low, high, '#') & in_range;
+    const std::uint32_t markers = byte_mask32(low, high, 'B') & in_range;
+
+    const int digit_end = 2 + lowest_set_bit(~(digits >> 2));
+    if (digit_end == 2 || digit_end > 2 + 19 || ((hashes >> digit_end) & (markers >> (digit_end + 1)) & 1u) == 0) {
+        return false;
+    }
+    const int base_first = digit_end + 2;
+    const int base_end = base_first + lowest_set_bit(~(digits >> base_first));
+    // Una base que llega al byte 32 puede seguir fuera de la ventana
+    if (base_end == base_first || base_end - base_first > 10 || base_end >= 32 ||
+        (nul_terminated && ((byte_mask32(low, high, '\0') >> base_end) & 1u) == 0)) {
+        return false;
+    }
+
+    // Las conversiones leen de una copia local con relleno: nada fuera del literal
+    char bytes[48] = {};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes), low);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + 16), high);
+    out.digit = convert_short_digits(bytes + 2, digit_end - 2);
+    out.base = convert_short_digits(bytes + base_first, base_end - base_first);
+    out.end = base_end;
+    return out.base != 0 && out.base - 1 <= 4294967295ULL;
+}
+
+#endif // XPERIMENT_RUNTIME_SIMD
+
+// Versión simplificada del parser de formato de dígito para MSVC C++14.
+// En ejecución se intenta antes la forma canónica "d#N#BM" (parse_digit_canonical).
+// En caso de error end_index señala dónde se detuvo el análisis (el dígito que desborda
+// en los Overflow); si no, el '\0' final.
+constexpr Expected<DigitResult, ParseError> parse_digit_format_simple(const char* const str, int& end_index) noexcept {
+    end_index = 0;
     if (str == nullptr || str[0] == '\0') {
         return make_unexpected(ParseError::Empty);
     }
 
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && (reinterpret_cast<std::uintptr_t>(str) & 4095u) <= 4096u - 32) {
+        CanonicalDigit canonical{};
+        if (parse_digit_canonical(str, 0xFFFFFFFFu, true, canonical)) {
+            end_index = canonical.end;
+            return Expected<DigitResult, ParseError>(DigitResult(canonical.digit, canonical.base));
+        }
+    }
+#endif
+
     int index = 0;
     
     // 1. Parsear prefix: "d" | "dig"
@@ -88,131 +562,230 @@ constexpr Expected<DigitResult, ParseError> parse_digit_format_simple(const char
             index += 2; // consumir "ig"
         }
     } else {
+        end_index = index;
         return make_unexpected(ParseError::InvalidPrefix);
     }
 
-    // 2. Skip blancos manualmente
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
-    }
+    // 2. Skip blancos
+    index = skip_whitespace(str, index);
 
     // 3. Parsear delimitador inicial: "#" | "[
     char opening_delimiter = str[index];
     if (opening_delimiter != '#' && opening_delimiter != '[') {
+        end_index = index;
         return make_unexpected(ParseError::MissingDelimiter);
     }
     index++; // consumir delimitador
 
     // 4. Skip blancos
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
-    }
+    index = skip_whitespace(str, index);
 
-    // 5. Parsear dígito - versión inline para evitar problemas con constexpr
+    // 5. Parsear dígito: overflow decidido por número de dígitos, como en parse_number_simple
     if (str[index] < '0' || str[index] > '9') {
+        end_index = index;
         return make_unexpected(ParseError::InvalidDigit);
     }
 
-    std::uint64_t digit = 0;
-    bool found_digit = false;
-
-    while (str[index] != '\0' && str[index] >= '0' && str[index] <= '9') {
-        found_digit = true;
-        std::uint64_t d = str[index] - '0';
-
-        // Verificar overflow para dígito
-        const std::uint64_t max_uint64 = 18446744073709551615ULL;
-        if (digit > max_uint64 / 10) {
-            return make_unexpected(ParseError::Overflow);
-        }
-
-        digit *= 10;
-
-        if (digit > max_uint64 - d) {
-            return make_unexpected(ParseError::Overflow);
-        }
-
-        digit += d;
-        index++;
-    }
-
-    if (!found_digit) {
-        return make_unexpected(ParseError::InvalidDigit);
+    int digit_end = index;
+    const Expected<std::uint64_t, ParseError> digit_value = parse_number_simple(str, index, digit_end);
+    if (!digit_value) {
+        end_index = digit_end;
+        return make_unexpected(ParseError::Overflow);
     }
+    const std::uint64_t digit = *digit_value;
+    index = digit_end;
 
     // 6. Skip blancos
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
-    }
+    index = skip_whitespace(str, index);
 
     // 7. Parsear delimitador de cierre
     char expected_closing = (opening_delimiter == '#') ? '#' : ']';
     if (str[index] != expected_closing) {
+        end_index = index;
         return make_unexpected(ParseError::MismatchedDelimiter);
     }
     index++; // consumir delimitador de cierre
 
     // 8. Skip blancos
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
-    }
+    index = skip_whitespace(str, index);
 
     // 9. Parsear "B"
     if (str[index] != 'B') {
+        end_index = index;
         return make_unexpected(ParseError::MissingB);
     }
     index++; // consumir 'B'
 
     // 10. Skip blancos
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
-    }
+    index = skip_whitespace(str, index);
 
-    // 11. Parsear base - versión inline
+    // 11. Parsear base
     if (str[index] < '0' || str[index] > '9') {
+        end_index = index;
         return make_unexpected(ParseError::InvalidBase);
     }
 
-    std::uint64_t base = 0;
-    bool found_base_digit = false;
+    int base_end = index;
+    const Expected<std::uint64_t, ParseError> base_value = parse_number_simple(str, index, base_end);
+    if (!base_value) {
+        end_index = base_end;
+        return make_unexpected(ParseError::Overflow);
+    }
+    const std::uint64_t base = *base_value;
 
-    while (str[index] != '\0' && str[index] >= '0' && str[index] <= '9') {
-        found_base_digit = true;
-        std::uint64_t b = str[index] - '0';
+    // 12. Validar que base-1 <= uint32_max
+    const std::uint64_t uint32_max = 4294967295ULL; // std::numeric_limits<std::uint32_t>::max()
+    if (base == 0 || (base - 1) > uint32_max) {
+        end_index = index;
+        return make_unexpected(ParseError::BaseOutOfRange);
+    }
 
-        // Verificar overflow para base
-        const std::uint64_t max_uint64 = 18446744073709551615ULL;
-        if (base > max_uint64 / 10) {
-            return make_unexpected(ParseError::Overflow);
-        }
+    index = base_end;
 
-        base *= 10;
+    // 13. Skip blancos finales y verificar que llegamos al final
+    index = skip_whitespace(str, index);
+    if (str[index] != '\0') {
+        end_index = index;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
 
-        if (base > max_uint64 - b) {
-            return make_unexpected(ParseError::Overflow);
+    end_index = index;
+    return Expected<DigitResult, ParseError>(DigitResult(digit, base));
+}
+
+constexpr Expected<DigitResult, ParseError> parse_digit_format_simple(const char* const str) noexcept {
+    int end_index = 0;
+    return parse_digit_format_simple(str, end_index);
+}
+
+// Literal terminado en '\0' con la posición del error
+constexpr Expected<DigitResult, ParseFailure> parse_digit_format_located(const char* const str) noexcept {
+    int end_index = 0;
+    return locate_failure(parse_digit_format_simple(str, end_index), static_cast<std::uint64_t>(end_index));
+}
+
+
+// Versión acotada del parser de formato de dígito: misma gramática sobre [first, last),
+// sin buscar '\0'. Como std::from_chars, se detiene tras el último dígito de la base y
+// deja en `end` el primer carácter no consumido; en caso de error, `end` señala dónde se
+// detuvo el análisis. Los blancos finales y lo que siga quedan a cargo del llamador.
+constexpr Expected<DigitResult, ParseError> parse_digit_format_simple(const char* const first, const char* const last, const char*& end) noexcept {
+    const char* p = first;
+    if (p == last) {
+        end = p;
+        return make_unexpected(ParseError::Empty);
+    }
+
+#if XPERIMENT_RUNTIME_SIMD
+    // Con menos de 32 bytes en el rango, la carga pasa de last sin salir de la página y
+    // los bytes de fuera se descartan con in_range
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() &&
+        (last - first >= 32 || (reinterpret_cast<std::uintptr_t>(first) & 4095u) <= 4096u - 32)) {
+        const std::uint32_t in_range = last - first >= 32 ? 0xFFFFFFFFu : (std::uint32_t(1) << (last - first)) - 1;
+        CanonicalDigit canonical{};
+        if (parse_digit_canonical(first, in_range, false, canonical)) {
+            end = first + canonical.end;
+            return Expected<DigitResult, ParseError>(DigitResult(canonical.digit, canonical.base));
         }
+    }
+#endif
 
-        base += b;
-        index++;
+    // 1. Prefijo: "d" | "dig"
+    if (*p != 'd') {
+        end = p;
+        return make_unexpected(ParseError::InvalidPrefix);
+    }
+    p++;
+    if (last - p >= 2 && p[0] == 'i' && p[1] == 'g') {
+        p += 2;
+    }
+
+    // 2-3. Delimitador inicial: "#" | "["
+    p = skip_whitespace(p, last);
+    if (p == last || (*p != '#' && *p != '[')) {
+        end = p;
+        return make_unexpected(ParseError::MissingDelimiter);
     }
+    const char expected_closing = (*p == '#') ? '#' : ']';
+    p++;
 
-    if (!found_base_digit) {
+    // 4-5. Dígito
+    p = skip_whitespace(p, last);
+    if (p == last || *p < '0' || *p > '9') {
+        end = p;
+        return make_unexpected(ParseError::InvalidDigit);
+    }
+    const char* digit_end = p;
+    const Expected<std::uint64_t, ParseError> digit = parse_number_simple(p, last, digit_end);
+    if (!digit) {
+        end = digit_end;
+        return make_unexpected(ParseError::Overflow);
+    }
+    p = digit_end;
+
+    // 6-7. Delimitador de cierre
+    p = skip_whitespace(p, last);
+    if (p == last || *p != expected_closing) {
+        end = p;
+        return make_unexpected(ParseError::MismatchedDelimiter);
+    }
+    p++;
+
+    // 8-9. "B"
+    p = skip_whitespace(p, last);
+    if (p == last || *p != 'B') {
+        end = p;
+        return make_unexpected(ParseError::MissingB);
+    }
+    p++;
+
+    // 10-11. Base
+    p = skip_whitespace(p, last);
+    if (p == last || *p < '0' || *p > '9') {
+        end = p;
         return make_unexpected(ParseError::InvalidBase);
     }
+    const char* base_end = p;
+    const Expected<std::uint64_t, ParseError> base = parse_number_simple(p, last, base_end);
+    if (!base) {
+        end = base_end;
+        return make_unexpected(ParseError::Overflow);
+    }
 
     // 12. Validar que base-1 <= uint32_max
-    const std::uint64_t uint32_max = 4294967295ULL; // std::numeric_limits<std::uint32_t>::max()
-    if (base == 0 || (base - 1) > uint32_max) {
+    const std::uint64_t uint32_max = 4294967295ULL;
+    if (*base == 0 || (*base - 1) > uint32_max) {
+        end = p;
         return make_unexpected(ParseError::BaseOutOfRange);
     }
 
-    // 13. Skip blancos finales y verificar que llegamos al final
-    while (str[index] == ' ' || str[index] == '\t' || str[index] == '\n' || str[index] == '\r') {
-        index++;
+    end = base_end;
+    return Expected<DigitResult, ParseError>(DigitResult(*digit, *base));
+}
+
+// Literal de dígito completo en [first, last): misma regla que la versión terminada en
+// '\0', es decir, sin blancos iniciales y con blancos finales permitidos. El error lleva
+// su desplazamiento desde first.
+constexpr Expected<DigitResult, ParseFailure> parse_digit_format_field_located(const char* const first, const char* const last) noexcept {
+    const char* end = first;
+    const Expected<DigitResult, ParseError> result = parse_digit_format_simple(first, last, end);
+    if (!result) {
+        return make_unexpected(ParseFailure(result.error(), static_cast<std::uint64_t>(end - first)));
     }
-    if (str[index] != '\0') {
-        return make_unexpected(ParseError::InvalidCharacter);
+    const char* const rest = skip_whitespace(end, last);
+    if (rest != last) {
+        return make_unexpected(ParseFailure(ParseError::InvalidCharacter, static_cast<std::uint64_t>(rest - first)));
     }
+    return Expected<DigitResult, ParseFailure>(*result);
+}
 
-    return Expected<DigitResult, ParseError>(DigitResult(digit, base));
+// Igual, sin la posición
+constexpr Expected<DigitResult, ParseError> parse_digit_format_field(const char* const first, const char* const last) noexcept {
+    const Expected<DigitResult, ParseFailure> result = parse_digit_format_field_located(first, last);
+    if (!result) {
+        return make_unexpected(result.error().code());
+    }
+    return Expected<DigitResult, ParseError>(*result);
 }
+
+#endif // PARSE_ERROR_HPP
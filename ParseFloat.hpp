@@ -0,0 +1,352 @@
+#ifndef PARSE_FLOAT_HPP
+#define PARSE_FLOAT_HPP
+
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <locale>
+#include <sstream>
+#include <string>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+#include "ParseInteger.hpp"
+#include "ParseFloatTable.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// parse_double: decimal -> double con redondeo correcto e independiente del locale.
+// Gramática: ['-'] dígitos ['.' dígitos] [('e' | 'E') ['+' | '-'] dígitos], con al menos
+// un dígito en la mantisa; sin "inf", "nan" ni hexadecimal.
+//
+// Caminos, de más a menos frecuente:
+//   1. Clinger: mantisa <= 2^53 y |exponente| <= 22, una sola operación exacta en double.
+//   2. Eisel-Lemire: mantisa de hasta 19 dígitos por la tabla de 5^q de 128 bits.
+//   3. Más de 19 dígitos significativos: Eisel-Lemire con la mantisa truncada w y con
+//      w + 1; si ambos dan el mismo double ese es el resultado, si no se recurre a la
+//      conversión de la biblioteca con el locale "C" (caso raro: valor en el límite).
+
+// Producto completo de 64 x 64 bits
+struct Product128 {
+    std::uint64_t low;
+    std::uint64_t high;
+};
+
+inline Product128 full_multiply(std::uint64_t a, std::uint64_t b) noexcept {
+#if XPERIMENT_HAS_INT128
+    const uint128 product = static_cast<uint128>(a) * b;
+    return Product128{static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64)};
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    Product128 product;
+    product.low = _umul128(a, b, &product.high);
+    return product;
+#else
+    // Cuatro productos de 32 x 32 bits
+    const std::uint64_t a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+    const std::uint64_t b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low;
+    const std::uint64_t high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high;
+    const std::uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + low_high;
+    return Product128{(middle << 32) | (low_low & 0xFFFFFFFFu),
+                      a_high * b_high + (high_low >> 32) + (middle >> 32)};
+#endif
+}
+
+inline int count_leading_zeros64(std::uint64_t value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - static_cast<int>(index);
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int zeros = 0;
+    while ((value & 0x8000000000000000ULL) == 0) {
+        value <<= 1;
+        zeros++;
+    }
+    return zeros;
+#else
+    return __builtin_clzll(value);
+#endif
+}
+
+// Resultado binario sin signo: mantisa de 52 bits y exponente sesgado (0x7FF = infinito)
+struct BinaryDouble {
+    std::uint64_t mantissa;
+    int power2;
+};
+
+constexpr int double_mantissa_bits = 52;
+constexpr int double_infinite_power = 0x7FF;
+
+inline bool operator==(const BinaryDouble& a, const BinaryDouble& b) noexcept {
+    return a.mantissa == b.mantissa && a.power2 == b.power2;
+}
+
+// Eisel-Lemire: w * 10^q redondeado al double más cercano (empates a par). w != 0 con
+// como mucho 19 dígitos; q fuera de la tabla es cero o infinito directamente.
+inline BinaryDouble eisel_lemire(std::int64_t q, std::uint64_t w) noexcept {
+    typedef PowersOfFive<> Powers;
+    if (w == 0 || q < Powers::smallest_power) {
+        return BinaryDouble{0, 0};
+    }
+    if (q > Powers::largest_power) {
+        return BinaryDouble{0, double_infinite_power};
+    }
+
+    const int leading_zeros = count_leading_zeros64(w);
+    w <<= leading_zeros;
+
+    // Primera aproximación con la palabra alta de 5^q; la baja solo hace falta si los bits
+    // que deciden el redondeo están todos a 1
+    const int index = 2 * static_cast<int>(q - Powers::smallest_power);
+    Product128 product = full_multiply(w, Powers::table[index]);
+    const std::uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFULL >> (double_mantissa_bits + 3);
+    if ((product.high & precision_mask) == precision_mask) {
+        const Product128 second = full_multiply(w, Powers::table[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            product.high++;
+        }
+    }
+
+    const int upper_bit = static_cast<int>(product.high >> 63);
+    const int shift = upper_bit + 64 - double_mantissa_bits - 3;
+    BinaryDouble answer;
+    answer.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 = ((152170 + 65536) * q) >> 16 + 63, y el sesgo 1023
+    answer.power2 = static_cast<int>(((152170 + 65536) * q) >> 16) + 63 + upper_bit - leading_zeros + 1023;
+
+    if (answer.power2 <= 0) {
+        // Subnormal (o cero si todos los bits quedan por debajo del mínimo)
+        if (-answer.power2 + 1 >= 64) {
+            return BinaryDouble{0, 0};
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        // Al redondear puede dejar de ser subnormal
+        answer.power2 = answer.mantissa < (1ULL << double_mantissa_bits) ? 0 : 1;
+        return answer;
+    }
+
+    // Empate exacto entre dos doubles: solo posible si 5^q cabe en 64 bits (q en [-4, 23]);
+    // en ese caso se redondea a par en lugar de hacia arriba
+    if (product.low <= 1 && q >= -4 && q <= 23 && (answer.mantissa & 3) == 1 &&
+        (answer.mantissa << shift) == product.high) {
+        answer.mantissa &= ~1ULL;
+    }
+
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (2ULL << double_mantissa_bits)) {
+        answer.mantissa = 1ULL << double_mantissa_bits;
+        answer.power2++;
+    }
+    answer.mantissa &= ~(1ULL << double_mantissa_bits);
+    if (answer.power2 >= double_infinite_power) {
+        return BinaryDouble{0, double_infinite_power};
+    }
+    return answer;
+}
+
+inline double double_from_bits(std::uint64_t bits) noexcept {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Camino de Clinger: 10^0..10^22 son exactos en double
+inline double exact_power_of_ten(int n) noexcept {
+    static const double powers[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return powers[n];
+}
+
+// Conversión de reserva para los casos en el límite: la de la biblioteca, pero siempre
+// con el locale "C" para que el separador decimal sea '.' sea cual sea el global
+inline Expected<double, ParseError> parse_double_fallback(const char* const first, const char* const last) {
+    std::istringstream stream(std::string(first, last));
+    stream.imbue(std::locale::classic());
+    double value = 0;
+    stream >> value;
+    if (stream.fail()) {
+        return make_unexpected(ParseError::Overflow);
+    }
+    return Expected<double, ParseError>(value);
+}
+
+// Versión acotada [first, last) al estilo std::from_chars. Errores:
+//   InvalidCharacter: no empieza por dígito, '.' o '-'   (end = first)
+//   InvalidMantissa:  mantisa sin dígitos                  (end = first)
+//   InvalidExponent:  'e' sin dígitos detrás               (end = la 'e')
+//   Overflow:         el valor no cabe en un double        (end = final del número)
+// Los valores por debajo del menor subnormal se redondean a cero sin error.
+inline Expected<double, ParseError> parse_double(const char* const first, const char* const last, const char*& end) {
+    const char* p = first;
+    const bool negative = p != last && *p == '-';
+    if (negative) {
+        p++;
+    }
+    if (p == last || ((*p < '0' || *p > '9') && *p != '.')) {
+        end = first;
+        return make_unexpected(negative ? ParseError::InvalidMantissa : ParseError::InvalidCharacter);
+    }
+
+    // Mantisa: parte entera y fraccionaria acumuladas juntas, 8 dígitos por bloque
+    // (si hay más de 19 el valor se desborda y se recalcula abajo)
+    const char* const integer_first = p;
+    std::uint64_t mantissa = 0;
+    while (last - p >= 8 && swar_is_eight_digits(swar_load8(p))) {
+        mantissa = mantissa * 100000000ULL + swar_parse_eight_digits(swar_load8(p));
+        p += 8;
+    }
+    while (p != last && *p >= '0' && *p <= '9') {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+        p++;
+    }
+    const char* const integer_last = p;
+    std::int64_t digit_count = integer_last - integer_first;
+    std::int64_t exponent = 0;
+
+    const char* fraction_first = p;
+    const char* fraction_last = p;
+    if (p != last && *p == '.') {
+        p++;
+        fraction_first = p;
+        while (last - p >= 8 && swar_is_eight_digits(swar_load8(p))) {
+            mantissa = mantissa * 100000000ULL + swar_parse_eight_digits(swar_load8(p));
+            p += 8;
+        }
+        while (p != last && *p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            p++;
+        }
+        fraction_last = p;
+        exponent = fraction_first - fraction_last;
+        digit_count -= exponent;
+    }
+    if (digit_count == 0) {
+        end = first;
+        return make_unexpected(ParseError::InvalidMantissa);
+    }
+
+    // Exponente decimal explícito; se satura para no desbordar con entradas absurdas
+    std::int64_t explicit_exponent = 0;
+    if (p != last && (*p == 'e' || *p == 'E')) {
+        const char* const exponent_marker = p;
+        p++;
+        const bool negative_exponent = p != last && *p == '-';
+        if (p != last && (*p == '-' || *p == '+')) {
+            p++;
+        }
+        if (p == last || *p < '0' || *p > '9') {
+            end = exponent_marker;
+            return make_unexpected(ParseError::InvalidExponent);
+        }
+        while (p != last && *p >= '0' && *p <= '9') {
+            if (explicit_exponent < 0x10000000) {
+                explicit_exponent = explicit_exponent * 10 + (*p - '0');
+            }
+            p++;
+        }
+        if (negative_exponent) {
+            explicit_exponent = -explicit_exponent;
+        }
+        exponent += explicit_exponent;
+    }
+    end = p;
+
+    // Más de 19 dígitos: sin contar los ceros iniciales, se toman los 19 primeros
+    bool truncated = false;
+    if (digit_count > 19) {
+        for (const char* s = integer_first; s != fraction_last && (*s == '0' || *s == '.'); ++s) {
+            if (*s == '0') {
+                digit_count--;
+            }
+        }
+        if (digit_count > 19) {
+            truncated = true;
+            const std::uint64_t min_nineteen_digits = 1000000000000000000ULL;
+            mantissa = 0;
+            const char* s = integer_first;
+            while (mantissa < min_nineteen_digits && s != integer_last) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*s - '0');
+                s++;
+            }
+            if (mantissa >= min_nineteen_digits) {
+                exponent = (integer_last - s) + explicit_exponent;
+            } else {
+                s = fraction_first;
+                while (mantissa < min_nineteen_digits && s != fraction_last) {
+                    mantissa = mantissa * 10 + static_cast<std::uint64_t>(*s - '0');
+                    s++;
+                }
+                exponent = (fraction_first - s) + explicit_exponent;
+            }
+        }
+    }
+
+    const std::uint64_t sign = negative ? 0x8000000000000000ULL : 0;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // Sin precisión extendida (x87) la operación en double es la correcta
+    if (!truncated && exponent >= -22 && exponent <= 22 && mantissa <= (1ULL << 53)) {
+        double value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / exact_power_of_ten(static_cast<int>(-exponent))
+                             : value * exact_power_of_ten(static_cast<int>(exponent));
+        return Expected<double, ParseError>(negative ? -value : value);
+    }
+#endif
+
+    const BinaryDouble binary = eisel_lemire(exponent, mantissa);
+    if (truncated && !(binary == eisel_lemire(exponent, mantissa + 1))) {
+        const Expected<double, ParseError> value = parse_double_fallback(negative ? first + 1 : first, end);
+        if (!value) {
+            return value;
+        }
+        return Expected<double, ParseError>(negative ? -*value : *value);
+    }
+    if (binary.power2 == double_infinite_power) {
+        return make_unexpected(ParseError::Overflow);
+    }
+    return Expected<double, ParseError>(double_from_bits(
+        sign | (static_cast<std::uint64_t>(binary.power2) << double_mantissa_bits) | binary.mantissa));
+}
+
+// Versión terminada en '\0' (desde start_index), como parse_number_simple. Se acota el
+// tramo de caracteres que pueden formar parte de un número y se usa la versión acotada.
+inline Expected<double, ParseError> parse_double(const char* const str, int start_index, int& end_index) {
+    const char* const first = str + start_index;
+    const char* last = first;
+    while ((*last >= '0' && *last <= '9') || *last == '.' || *last == 'e' || *last == 'E' ||
+           *last == '+' || *last == '-') {
+        last++;
+    }
+    const char* end = first;
+    const Expected<double, ParseError> value = parse_double(first, last, end);
+    end_index = static_cast<int>(end - str);
+    return value;
+}
+
+struct DoubleFieldParser {
+    static Expected<double, ParseError> parse(const char* first, const char* last, const char*& end) {
+        return parse_double(first, last, end);
+    }
+    static constexpr bool is_digit(char c) noexcept { return (c >= '0' && c <= '9') || c == '.'; }
+};
+
+// Campo completo en [first, last) con las reglas de parse_number_field
+inline Expected<double, ParseError> parse_double_field(const char* const first, const char* const last) {
+    return parse_field<double, DoubleFieldParser>(first, last);
+}
+
+inline Expected<double, ParseFailure> parse_double_field_located(const char* const first, const char* const last) {
+    return parse_field_located<double, DoubleFieldParser>(first, last);
+}
+
+#endif // PARSE_FLOAT_HPP
@@ -0,0 +1,273 @@
+#ifndef PARSE_INGEST_HPP
+#define PARSE_INGEST_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Ingesta de ficheros completos: el fichero se proyecta en memoria, se parte en trozos
+// alineados a final de línea y cada trozo se parsea en su propio hilo escribiendo
+// directamente en su tramo del resultado final, de modo que no hay fusión posterior.
+
+// Proyección de solo lectura de un fichero completo (RAII)
+class MappedFile {
+public:
+    explicit MappedFile(const char* const path) {
+#if defined(_WIN32)
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            const DWORD error = GetLastError();
+            CloseHandle(file_);
+            throw std::system_error(static_cast<int>(error), std::system_category(), path);
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ != 0) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            data_ = mapping_ != nullptr ? static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+            if (data_ == nullptr) {
+                const DWORD error = GetLastError();
+                if (mapping_ != nullptr) CloseHandle(mapping_);
+                CloseHandle(file_);
+                throw std::system_error(static_cast<int>(error), std::system_category(), path);
+            }
+        }
+#else
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        struct stat info;
+        if (::fstat(fd_, &info) != 0) {
+            const int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ != 0) {
+            void* const address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (address == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd_);
+                throw std::system_error(error, std::generic_category(), path);
+            }
+            // Cada hilo recorre su trozo de forma secuencial
+            ::madvise(address, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(address);
+        }
+#endif
+    }
+
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_ != nullptr) CloseHandle(mapping_);
+        CloseHandle(file_);
+#else
+        if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+        ::close(fd_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const noexcept { return data_; }
+    const char* end() const noexcept { return data_ + size_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+struct NumberIngestResult {
+    std::vector<std::uint64_t> values;  // Un valor por línea (0 en las líneas con error)
+    std::vector<LineError> errors;      // Ordenados por línea
+};
+
+struct DigitIngestResult {
+    std::vector<std::uint64_t> digits;  // Dígito de cada línea (0 en las líneas con error)
+    std::vector<std::uint64_t> bases;   // Base de cada línea (0 en las líneas con error)
+    std::vector<LineError> errors;      // Ordenados por línea
+};
+
+// Parte [first, last) en como mucho `parts` trozos que terminan justo después de un '\n'
+// (el último termina en last). Devuelve los límites: trozo i = [bounds[i], bounds[i + 1]).
+inline std::vector<const char*> split_at_lines(const char* const first, const char* const last, std::size_t parts) {
+    std::vector<const char*> bounds;
+    bounds.push_back(first);
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    for (std::size_t i = 1; i < parts; ++i) {
+        const char* cut = first + size / parts * i;
+        if (cut <= bounds.back()) {
+            continue;
+        }
+        const void* const newline = std::memchr(cut - 1, '\n', static_cast<std::size_t>(last - cut + 1));
+        cut = newline != nullptr ? static_cast<const char*>(newline) + 1 : last;
+        if (cut != last && cut != bounds.back()) {
+            bounds.push_back(cut);
+        }
+    }
+    bounds.push_back(last);
+    return bounds;
+}
+
+inline unsigned ingest_thread_count(unsigned requested) noexcept {
+    if (requested != 0) {
+        return requested;
+    }
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware != 0 ? hardware : 1;
+}
+
+// Ejecuta body(i) para cada trozo, uno por hilo (el trozo 0 en el hilo que llama)
+template<typename Body>
+void run_per_chunk(std::size_t chunks, Body&& body) {
+    std::vector<std::thread> workers;
+    workers.reserve(chunks > 0 ? chunks - 1 : 0);
+    for (std::size_t i = 1; i < chunks; ++i) {
+        workers.emplace_back([&body, i] { body(i); });
+    }
+    if (chunks > 0) {
+        body(0);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// Reparto de un buffer en trozos de líneas completas con su primera línea global
+struct LineChunks {
+    std::vector<const char*> bounds;    // Trozo i = [bounds[i], bounds[i + 1])
+    std::vector<std::size_t> offsets;   // Primera línea del trozo i; offsets.back() = total
+
+    std::size_t size() const noexcept { return bounds.size() - 1; }
+    std::size_t lines(std::size_t i) const noexcept { return offsets[i + 1] - offsets[i]; }
+    std::size_t total_lines() const noexcept { return offsets.back(); }
+};
+
+// Ejecutor de un hilo por trozo para plan_line_chunks / parse_line_chunks. Cualquier
+// objeto con run(trozos, body) que llame a body(i) para cada trozo sirve igual.
+struct ThreadPerChunk {
+    template<typename Body>
+    void run(std::size_t chunks, Body&& body) const {
+        run_per_chunk(chunks, body);
+    }
+};
+
+// Fase 1: se cuentan las líneas de cada trozo y se calculan las sumas prefijas
+template<typename Runner>
+LineChunks plan_line_chunks(std::vector<const char*> bounds, Runner&& runner) {
+    LineChunks plan;
+    plan.bounds = std::move(bounds);
+    plan.offsets.assign(plan.bounds.size(), 0);
+    runner.run(plan.size(), [&plan](std::size_t i) {
+        plan.offsets[i + 1] = count_lines(plan.bounds[i], plan.bounds[i + 1]);
+    });
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        plan.offsets[i + 1] += plan.offsets[i];
+    }
+    return plan;
+}
+
+// Un trozo por hilo
+inline LineChunks plan_line_chunks(const char* const first, const char* const last, unsigned threads) {
+    return plan_line_chunks(split_at_lines(first, last, ingest_thread_count(threads)), ThreadPerChunk{});
+}
+
+// Fase 2: parse_chunk(i, errores) parsea el trozo i en su tramo del resultado final;
+// los errores de cada trozo se concatenan en orden de entrada, con el byte del error
+// pasado de relativo al trozo a relativo al buffer completo
+template<typename Runner, typename ParseChunk>
+std::vector<LineError> parse_line_chunks(const LineChunks& plan, Runner&& runner, ParseChunk&& parse_chunk) {
+    std::vector<std::vector<LineError>> chunk_errors(plan.size());
+    runner.run(plan.size(), [&](std::size_t i) {
+        parse_chunk(i, chunk_errors[i]);
+    });
+
+    std::vector<LineError> errors;
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        const std::uint64_t chunk_offset = static_cast<std::uint64_t>(plan.bounds[i] - plan.bounds[0]);
+        for (LineError error : chunk_errors[i]) {
+            error.offset += chunk_offset;
+            errors.push_back(error);
+        }
+    }
+    return errors;
+}
+
+template<typename ParseChunk>
+std::vector<LineError> parse_line_chunks(const LineChunks& plan, ParseChunk&& parse_chunk) {
+    return parse_line_chunks(plan, ThreadPerChunk{}, parse_chunk);
+}
+
+// Parsea en paralelo un buffer de números separados por '\n' (threads = 0: todos los núcleos)
+inline NumberIngestResult parse_number_lines_parallel(const char* const first, const char* const last, unsigned threads = 0) {
+    const LineChunks plan = plan_line_chunks(first, last, threads);
+    NumberIngestResult result;
+    result.values.resize(plan.total_lines());
+    result.errors = parse_line_chunks(plan, [&](std::size_t i, std::vector<LineError>& errors) {
+        parse_number_lines(plan.bounds[i], plan.bounds[i + 1], result.values.data() + plan.offsets[i],
+                           plan.lines(i), errors, plan.offsets[i]);
+    });
+    return result;
+}
+
+// Parsea en paralelo un buffer de literales de dígito, uno por línea
+inline DigitIngestResult parse_digit_lines_parallel(const char* const first, const char* const last, unsigned threads = 0) {
+    const LineChunks plan = plan_line_chunks(first, last, threads);
+    DigitIngestResult result;
+    result.digits.resize(plan.total_lines());
+    result.bases.resize(plan.total_lines());
+    result.errors = parse_line_chunks(plan, [&](std::size_t i, std::vector<LineError>& errors) {
+        parse_digit_lines(plan.bounds[i], plan.bounds[i + 1], result.digits.data() + plan.offsets[i],
+                          result.bases.data() + plan.offsets[i], plan.lines(i), errors, plan.offsets[i]);
+    });
+    return result;
+}
+
+// Ingesta de un fichero de números, uno por línea. Lanza std::system_error si no se puede abrir.
+inline NumberIngestResult ingest_number_file(const char* const path, unsigned threads = 0) {
+    const MappedFile file(path);
+    return parse_number_lines_parallel(file.begin(), file.end(), threads);
+}
+
+// Ingesta de un fichero de literales "d#N#BM" / "dig[N]BM", uno por línea
+inline DigitIngestResult ingest_digit_file(const char* const path, unsigned threads = 0) {
+    const MappedFile file(path);
+    return parse_digit_lines_parallel(file.begin(), file.end(), threads);
+}
+
+#endif // PARSE_INGEST_HPP
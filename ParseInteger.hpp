@@ -0,0 +1,203 @@
+#ifndef PARSE_INTEGER_HPP
+#define PARSE_INTEGER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+
+// parse_integer<T>: la lógica de parse_number_simple para cualquier entero con o sin
+// signo (int8..int64, uint8..uint64 y 128 bits si el compilador los tiene). Cada
+// instanciación conoce en compilación su límite y su número máximo de dígitos, así que
+// el bucle no lleva comprobaciones hasta el último dígito posible.
+
+#if defined(__SIZEOF_INT128__)
+#define XPERIMENT_HAS_INT128 1
+// __extension__ evita el aviso de -pedantic: __int128 no es ISO C++
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#else
+#define XPERIMENT_HAS_INT128 0
+#endif
+
+// Tabla de límites por tipo. Accumulator es el tipo sin signo en el que se acumula la
+// magnitud: 32 bits para los tipos de hasta 32 bits (aritmética más barata en
+// plataformas de 32 bits y sin promociones raras de uint8/uint16), 64 para los de 64.
+template<typename T>
+struct IntegerTraits {
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "parse_integer requiere un tipo entero");
+
+    using Accumulator = typename std::conditional<(sizeof(T) <= 4), std::uint32_t, std::uint64_t>::type;
+
+    static constexpr bool is_signed = std::is_signed<T>::value;
+    static constexpr Accumulator max_positive = static_cast<Accumulator>(std::numeric_limits<T>::max());
+    static constexpr Accumulator max_negative = is_signed ? max_positive + 1 : 0;  // |min|
+};
+
+#if XPERIMENT_HAS_INT128
+template<>
+struct IntegerTraits<uint128> {
+    using Accumulator = uint128;
+
+    static constexpr bool is_signed = false;
+    static constexpr Accumulator max_positive = ~static_cast<uint128>(0);
+    static constexpr Accumulator max_negative = 0;
+};
+
+template<>
+struct IntegerTraits<int128> {
+    using Accumulator = uint128;
+
+    static constexpr bool is_signed = true;
+    static constexpr Accumulator max_positive = ~static_cast<uint128>(0) >> 1;
+    static constexpr Accumulator max_negative = max_positive + 1;
+};
+#endif
+
+// Número de dígitos decimales de un valor (1 para el 0)
+template<typename A>
+constexpr int decimal_digit_count(A value) noexcept {
+    int digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        digits++;
+    }
+    return digits;
+}
+
+// accumulate_digits en el tipo del acumulador: bloques de 8 por SWAR y el resto dígito
+// a dígito. `count` dígitos ya validados cuyo valor cabe en A.
+template<typename A>
+constexpr A accumulate_digits_as(const char* p, int count) noexcept {
+    A result = 0;
+    while (count >= 8) {
+        result = result * 100000000u + swar_parse_eight_digits(swar_load8(p));
+        p += 8;
+        count -= 8;
+    }
+    while (count > 0) {
+        result = result * 10u + static_cast<A>(*p - '0');
+        p++;
+        count--;
+    }
+    return result;
+}
+
+// Magnitud -> T. La negación se hace en el acumulador sin signo (módulo 2^n) para no
+// negar el mínimo en T; la conversión final es la de complemento a dos.
+template<typename T, bool Negative, typename A>
+constexpr T integer_from_magnitude(A magnitude) noexcept {
+    return static_cast<T>(Negative ? static_cast<A>(0 - magnitude) : magnitude);
+}
+
+// Núcleo común: convierte la racha de `count` dígitos significativos ya medida.
+// Hasta max_digits - 1 dígitos no hay comprobación; el último dígito posible se compara
+// una vez con límite / 10 y límite % 10 (constantes de la instanciación); con más
+// dígitos es overflow. En caso de overflow `end` señala el dígito que desborda.
+template<typename T, bool Negative>
+constexpr Expected<T, ParseError> convert_integer_run(const char* const significant, int count, const char*& end) noexcept {
+    using Traits = IntegerTraits<T>;
+    using A = typename Traits::Accumulator;
+    constexpr A limit = Negative ? Traits::max_negative : Traits::max_positive;
+    constexpr int max_digits = decimal_digit_count(limit);
+
+    if (count < max_digits) {
+        end = significant + count;
+        return Expected<T, ParseError>(integer_from_magnitude<T, Negative>(accumulate_digits_as<A>(significant, count)));
+    }
+
+    const A head = accumulate_digits_as<A>(significant, max_digits - 1);
+    const A last_digit = static_cast<A>(significant[max_digits - 1] - '0');
+    if (head > limit / 10 || (head == limit / 10 && last_digit > limit % 10)) {
+        end = significant + max_digits - 1;
+        return make_unexpected(ParseError::Overflow);
+    }
+    if (count > max_digits) {
+        end = significant + max_digits;
+        return make_unexpected(ParseError::Overflow);
+    }
+
+    end = significant + max_digits;
+    return Expected<T, ParseError>(integer_from_magnitude<T, Negative>(head * 10u + last_digit));
+}
+
+// Igual que parse_number_simple (cadena terminada en '\0', desde start_index) para el
+// tipo T. Los tipos con signo admiten un '-' inicial; "-" sin dígitos y el '-' en tipos
+// sin signo son InvalidCharacter. Con T = std::uint64_t el resultado, el error y
+// end_index coinciden con parse_number_simple.
+template<typename T>
+constexpr Expected<T, ParseError> parse_integer(const char* const str, int start_index, int& end_index) noexcept {
+    const bool negative = IntegerTraits<T>::is_signed && str[start_index] == '-';
+    const int digits_start = negative ? start_index + 1 : start_index;
+    if (str[digits_start] < '0' || str[digits_start] > '9') {
+        end_index = start_index;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    int first_significant = digits_start;
+    while (str[first_significant] == '0') {
+        first_significant++;
+    }
+    int index = first_significant;
+    while (str[index] >= '0' && str[index] <= '9') {
+        index++;
+    }
+
+    const char* end = str + index;
+    const Expected<T, ParseError> result = negative
+        ? convert_integer_run<T, true>(str + first_significant, index - first_significant, end)
+        : convert_integer_run<T, false>(str + first_significant, index - first_significant, end);
+    end_index = static_cast<int>(end - str);
+    return result;
+}
+
+// Versión acotada [first, last) al estilo std::from_chars, como parse_number_simple
+template<typename T>
+constexpr Expected<T, ParseError> parse_integer(const char* const first, const char* const last, const char*& end) noexcept {
+    const bool negative = IntegerTraits<T>::is_signed && first != last && *first == '-';
+    const char* const digits_start = negative ? first + 1 : first;
+    if (digits_start == last || *digits_start < '0' || *digits_start > '9') {
+        end = first;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    const char* significant = digits_start;
+    while (significant != last && *significant == '0') {
+        significant++;
+    }
+    const char* p = significant;
+    while (last - p >= 8 && swar_is_eight_digits(swar_load8(p))) {
+        p += 8;
+    }
+    while (p != last && *p >= '0' && *p <= '9') {
+        p++;
+    }
+
+    const int count = static_cast<int>(p - significant);
+    return negative
+        ? convert_integer_run<T, true>(significant, count, end)
+        : convert_integer_run<T, false>(significant, count, end);
+}
+
+template<typename T>
+struct IntegerFieldParser {
+    static constexpr Expected<T, ParseError> parse(const char* first, const char* last, const char*& end) noexcept {
+        return parse_integer<T>(first, last, end);
+    }
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+};
+
+// Campo completo en [first, last) con las reglas de parse_number_field
+template<typename T>
+constexpr Expected<T, ParseError> parse_integer_field(const char* const first, const char* const last) noexcept {
+    return parse_field<T, IntegerFieldParser<T>>(first, last);
+}
+
+template<typename T>
+constexpr Expected<T, ParseFailure> parse_integer_field_located(const char* const first, const char* const last) noexcept {
+    return parse_field_located<T, IntegerFieldParser<T>>(first, last);
+}
+
+#endif // PARSE_INTEGER_HPP
@@ -0,0 +1,215 @@
+#ifndef PARSE_POOL_HPP
+#define PARSE_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+#include "ParseIngest.hpp"
+
+// Parseo paralelo con robo de trabajo: el buffer se parte en muchas tareas pequeñas
+// alineadas a final de línea y un pool de hilos persistente las reparte. Cada
+// participante empieza con un tramo contiguo de tareas; el que se queda sin trabajo
+// roba la mitad final del tramo de otro. Así una zona cara (líneas largas, muchos
+// errores) no deja a los demás hilos esperando como con un reparto estático.
+// Los resultados salen en orden de entrada porque cada tarea escribe en su tramo,
+// calculado con las mismas dos fases que parse_number_lines_parallel.
+
+// Pool reutilizable entre llamadas: los hilos se crean una vez y esperan entre lotes
+class ParsePool {
+public:
+    // threads = participantes, contando el hilo que llama a run (0: todos los núcleos)
+    explicit ParsePool(unsigned threads = 0)
+        : ranges_(new TaskRange[ingest_thread_count(threads)]),
+          participants_(ingest_thread_count(threads)) {
+        workers_.reserve(participants_ - 1);
+        for (unsigned i = 1; i < participants_; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~ParsePool() {
+        {
+            const std::lock_guard<std::mutex> guard(lock_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ParsePool(const ParsePool&) = delete;
+    ParsePool& operator=(const ParsePool&) = delete;
+
+    unsigned size() const noexcept { return participants_; }
+
+    // Ejecuta body(i) para i en [0, tasks) y vuelve cuando han terminado todas. body no
+    // debe lanzar ni llamar a run del mismo pool; llamadas a run desde varios hilos se
+    // ejecutan una detrás de otra.
+    template<typename Body>
+    void run(std::size_t tasks, Body&& body) {
+        const std::lock_guard<std::mutex> serial(run_lock_);
+        if (tasks == 0) {
+            return;
+        }
+        using Decayed = typename std::remove_reference<Body>::type;
+        {
+            const std::lock_guard<std::mutex> guard(lock_);
+            body_ = const_cast<void*>(static_cast<const void*>(&body));
+            invoke_ = [](void* body, std::size_t task) { (*static_cast<Decayed*>(body))(task); };
+            for (unsigned i = 0; i < participants_; ++i) {
+                ranges_[i].next = tasks * i / participants_;
+                ranges_[i].end = tasks * (i + 1) / participants_;
+            }
+            busy_workers_ = participants_ - 1;
+            generation_++;
+        }
+        wake_.notify_all();
+        work(0);
+
+        std::unique_lock<std::mutex> guard(lock_);
+        done_.wait(guard, [this] { return busy_workers_ == 0; });
+    }
+
+private:
+    // Tramo de tareas pendientes [next, end) de un participante; el relleno evita que
+    // dos tramos compartan línea de caché
+    struct TaskRange {
+        std::mutex lock;
+        std::size_t next = 0;
+        std::size_t end = 0;
+        char padding[64];
+    };
+
+    void worker_loop(unsigned index) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                wake_.wait(guard, [this, seen] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            work(index);
+            bool last;
+            {
+                const std::lock_guard<std::mutex> guard(lock_);
+                last = --busy_workers_ == 0;
+            }
+            if (last) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    // Tareas del propio tramo por delante; sin ellas, robo de la mitad final de otro
+    void work(unsigned index) {
+        TaskRange& own = ranges_[index];
+        for (;;) {
+            std::size_t task = 0;
+            bool found = false;
+            {
+                const std::lock_guard<std::mutex> guard(own.lock);
+                if (own.next != own.end) {
+                    task = own.next++;
+                    found = true;
+                }
+            }
+            if (!found && !steal(index, task)) {
+                return;
+            }
+            invoke_(body_, task);
+        }
+    }
+
+    // Roba a la primera víctima con trabajo: se queda una tarea para ejecutarla ya y
+    // publica el resto de lo robado como su nuevo tramo
+    bool steal(unsigned index, std::size_t& task) {
+        for (unsigned offset = 1; offset < participants_; ++offset) {
+            TaskRange& victim = ranges_[(index + offset) % participants_];
+            std::size_t first;
+            std::size_t last;
+            {
+                const std::lock_guard<std::mutex> guard(victim.lock);
+                const std::size_t remaining = victim.end - victim.next;
+                if (remaining == 0) {
+                    continue;
+                }
+                last = victim.end;
+                first = last - (remaining + 1) / 2;
+                victim.end = first;
+            }
+            TaskRange& own = ranges_[index];
+            const std::lock_guard<std::mutex> guard(own.lock);
+            own.next = first + 1;
+            own.end = last;
+            task = first;
+            return true;
+        }
+        return false;
+    }
+
+    std::unique_ptr<TaskRange[]> ranges_;
+    unsigned participants_;
+    std::vector<std::thread> workers_;
+
+    std::mutex run_lock_;
+    std::mutex lock_;  // Protege lo siguiente
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    unsigned busy_workers_ = 0;
+    bool stop_ = false;
+    void* body_ = nullptr;
+    void (*invoke_)(void*, std::size_t) = nullptr;
+};
+
+// Tamaño de tarea por defecto: bastante más pequeño que un trozo por hilo para que el
+// robo reparta bien, y lo bastante grande para que el reparto no cueste
+constexpr std::size_t default_task_bytes = 64 * 1024;
+
+// Parte [first, last) en tareas de unos task_bytes bytes y las cuenta en el pool
+inline LineChunks plan_line_tasks(ParsePool& pool, const char* const first, const char* const last, std::size_t task_bytes) {
+    const std::size_t size = static_cast<std::size_t>(last - first);
+    const std::size_t tasks = task_bytes != 0 && size > task_bytes ? size / task_bytes : 1;
+    return plan_line_chunks(split_at_lines(first, last, tasks), pool);
+}
+
+// Como parse_number_lines_parallel, con tareas pequeñas repartidas por el pool
+inline NumberIngestResult parse_number_lines_pooled(ParsePool& pool, const char* const first, const char* const last,
+                                                    std::size_t task_bytes = default_task_bytes) {
+    const LineChunks plan = plan_line_tasks(pool, first, last, task_bytes);
+    NumberIngestResult result;
+    result.values.resize(plan.total_lines());
+    result.errors = parse_line_chunks(plan, pool, [&](std::size_t i, std::vector<LineError>& errors) {
+        parse_number_lines(plan.bounds[i], plan.bounds[i + 1], result.values.data() + plan.offsets[i],
+                           plan.lines(i), errors, plan.offsets[i]);
+    });
+    return result;
+}
+
+// Como parse_digit_lines_parallel, con tareas pequeñas repartidas por el pool
+inline DigitIngestResult parse_digit_lines_pooled(ParsePool& pool, const char* const first, const char* const last,
+                                                  std::size_t task_bytes = default_task_bytes) {
+    const LineChunks plan = plan_line_tasks(pool, first, last, task_bytes);
+    DigitIngestResult result;
+    result.digits.resize(plan.total_lines());
+    result.bases.resize(plan.total_lines());
+    result.errors = parse_line_chunks(plan, pool, [&](std::size_t i, std::vector<LineError>& errors) {
+        parse_digit_lines(plan.bounds[i], plan.bounds[i + 1], result.digits.data() + plan.offsets[i],
+                          result.bases.data() + plan.offsets[i], plan.lines(i), errors, plan.offsets[i]);
+    });
+    return result;
+}
+
+#endif // PARSE_POOL_HPP
@@ -0,0 +1,286 @@
+#ifndef PARSE_RADIX_HPP
+#define PARSE_RADIX_HPP
+
+#include <cstdint>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+
+// parse_number<Radix>: parse_number_simple para bases 2..36 (sin prefijo "0x"/"0b"; las
+// letras valen en mayúscula o minúscula). Las bases 2, 8 y 16 validan, convierten y
+// empaquetan 8 caracteres por operación sin saltos (SWAR); el resto usa un bucle
+// escalar. En todas el overflow se decide por número de dígitos con cotas de compilación.
+
+// Tabla de valor de dígito por carácter: 0..35 para '0'..'9', 'a'..'z' y 'A'..'Z', 36 para
+// el resto. Una carga por carácter en lugar de comparar rangos (en hexadecimal la
+// alternancia dígito/letra es impredecible y los saltos salen caros).
+struct RadixDigitTable {
+    unsigned char value[256];
+};
+
+constexpr RadixDigitTable make_radix_digit_table() noexcept {
+    RadixDigitTable table{};
+    for (int c = 0; c < 256; ++c) {
+        table.value[c] = (c >= '0' && c <= '9') ? static_cast<unsigned char>(c - '0')
+                       : (c >= 'a' && c <= 'z') ? static_cast<unsigned char>(c - 'a' + 10)
+                       : (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 10)
+                       : static_cast<unsigned char>(36);
+    }
+    return table;
+}
+
+// Miembro estático de una plantilla: una sola copia en todo el programa aunque la
+// cabecera se incluya en varias unidades de traducción (C++14 no tiene variables inline)
+template<typename Unused = void>
+struct RadixDigitValues {
+    static constexpr RadixDigitTable table = make_radix_digit_table();
+};
+
+template<typename Unused>
+constexpr RadixDigitTable RadixDigitValues<Unused>::table;
+
+// Valor de un carácter como dígito en bases hasta 36; 36 si no es un dígito de ninguna
+constexpr unsigned radix_digit_value(char c) noexcept {
+    return RadixDigitValues<>::table.value[static_cast<unsigned char>(c)];
+}
+
+// ¿Es `c` un dígito de base Radix?
+template<unsigned Radix>
+constexpr bool is_radix_digit(char c) noexcept {
+    return radix_digit_value(c) < Radix;
+}
+
+// Número de dígitos de `value` en base `radix` (1 para el 0)
+constexpr int radix_digit_count(std::uint64_t value, unsigned radix) noexcept {
+    int digits = 1;
+    while (value >= radix) {
+        value /= radix;
+        digits++;
+    }
+    return digits;
+}
+
+// radix^n sin comprobar overflow (n < número de dígitos de 2^64 - 1 en esa base)
+constexpr std::uint64_t radix_power(unsigned radix, int n) noexcept {
+    std::uint64_t power = 1;
+    while (n-- > 0) {
+        power *= radix;
+    }
+    return power;
+}
+
+// Marca con 0x80 los bytes distintos de cero
+constexpr std::uint64_t swar_nonzero_bytes(std::uint64_t word) noexcept {
+    return (((word & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | word) & 0x8080808080808080ULL;
+}
+
+// Junta 8 valores de dígito (un byte cada uno, el primero el más significativo) con la
+// misma multiplica-y-desplaza que swar_parse_eight_digits; vale mientras Radix^8 < 2^32
+template<std::uint64_t Radix>
+constexpr std::uint32_t swar_combine_eight(std::uint64_t values) noexcept {
+    values = (values * (Radix * 0x100ULL + 1)) >> 8;
+    values = ((values & 0x00FF00FF00FF00FFULL) * (Radix * Radix * 0x10000ULL + 1)) >> 16;
+    return static_cast<std::uint32_t>(
+        ((values & 0x0000FFFF0000FFFFULL) * (Radix * Radix * Radix * Radix * 0x100000000ULL + 1)) >> 32);
+}
+
+// Núcleos SWAR por base: invalid() marca con 0x80 los bytes que no son dígitos, values()
+// deja en cada byte el valor de su dígito y pack() junta los 8 valores en 8 * Bits bits.
+// La plantilla general no tiene núcleo: todo byte es inválido y se usa el bucle escalar.
+template<unsigned Radix>
+struct SwarRadix {
+    static constexpr bool enabled = false;
+    static constexpr int bits = 0;
+    static constexpr std::uint64_t invalid(std::uint64_t) noexcept { return 0x8080808080808080ULL; }
+    static constexpr std::uint64_t values(std::uint64_t) noexcept { return 0; }
+    static constexpr std::uint32_t pack(std::uint64_t) noexcept { return 0; }
+};
+
+// Binario: '0' = 0x30 y '1' = 0x31, solo puede variar el bit bajo. El empaquetado lleva el
+// bit de cada byte a su posición en el byte alto con una única multiplicación.
+template<>
+struct SwarRadix<2> {
+    static constexpr bool enabled = true;
+    static constexpr int bits = 1;
+    static constexpr std::uint64_t invalid(std::uint64_t word) noexcept {
+        return swar_nonzero_bytes((word & 0xFEFEFEFEFEFEFEFEULL) ^ 0x3030303030303030ULL);
+    }
+    static constexpr std::uint64_t values(std::uint64_t word) noexcept { return word & 0x0101010101010101ULL; }
+    static constexpr std::uint32_t pack(std::uint64_t values) noexcept {
+        return static_cast<std::uint32_t>((values * 0x8040201008040201ULL) >> 56);
+    }
+};
+
+// Octal: '0'..'7' = 0x30..0x37, los 3 bits bajos son el valor
+template<>
+struct SwarRadix<8> {
+    static constexpr bool enabled = true;
+    static constexpr int bits = 3;
+    static constexpr std::uint64_t invalid(std::uint64_t word) noexcept {
+        return swar_nonzero_bytes((word & 0xF8F8F8F8F8F8F8F8ULL) ^ 0x3030303030303030ULL);
+    }
+    static constexpr std::uint64_t values(std::uint64_t word) noexcept { return word & 0x0707070707070707ULL; }
+    static constexpr std::uint32_t pack(std::uint64_t values) noexcept { return swar_combine_eight<8>(values); }
+};
+
+// Hexadecimal: rangos '0'..'9' y 'a'..'f' (con el bit 0x20 forzado para admitir
+// mayúsculas) comprobados byte a byte con sumas que no propagan acarreo. El valor es el
+// nibble bajo, más 9 en las letras (bit 0x40).
+template<>
+struct SwarRadix<16> {
+    static constexpr bool enabled = true;
+    static constexpr int bits = 4;
+    static constexpr std::uint64_t invalid(std::uint64_t word) noexcept {
+        const std::uint64_t ascii = ~word & 0x8080808080808080ULL;
+        const std::uint64_t low = word & 0x7F7F7F7F7F7F7F7FULL;
+        const std::uint64_t lower = low | 0x2020202020202020ULL;
+        const std::uint64_t digit = (low + 0x5050505050505050ULL) & ~(low + 0x4646464646464646ULL);       // '0'..'9'
+        const std::uint64_t letter = (lower + 0x1F1F1F1F1F1F1F1FULL) & ~(lower + 0x1919191919191919ULL);  // 'a'..'f'
+        return ~((digit | letter) & ascii) & 0x8080808080808080ULL;
+    }
+    static constexpr std::uint64_t values(std::uint64_t word) noexcept {
+        return (word & 0x0F0F0F0F0F0F0F0FULL) + 9 * ((word >> 6) & 0x0101010101010101ULL);
+    }
+    static constexpr std::uint32_t pack(std::uint64_t values) noexcept { return swar_combine_eight<16>(values); }
+};
+
+// Final de la racha de dígitos de base Radix que empieza en p
+template<unsigned Radix>
+constexpr const char* radix_digit_run_end(const char* p, const char* const last) noexcept {
+    if (SwarRadix<Radix>::enabled) {
+        while (last - p >= 8) {
+            const std::uint64_t invalid = SwarRadix<Radix>::invalid(swar_load8(p));
+            if (invalid != 0) {
+                return p + swar_leading_clear_bytes(invalid);
+            }
+            p += 8;
+        }
+    }
+    while (p != last && is_radix_digit<Radix>(*p)) {
+        p++;
+    }
+    return p;
+}
+
+// Acumula `count` dígitos ya validados cuyo valor cabe en un uint64_t
+template<unsigned Radix>
+constexpr std::uint64_t accumulate_radix_digits(const char* p, int count) noexcept {
+    std::uint64_t result = 0;
+    if (SwarRadix<Radix>::enabled) {
+        while (count >= 8) {
+            const std::uint64_t block = SwarRadix<Radix>::pack(SwarRadix<Radix>::values(swar_load8(p)));
+            result = (result << (8 * SwarRadix<Radix>::bits)) | block;
+            p += 8;
+            count -= 8;
+        }
+    }
+    while (count > 0) {
+        result = result * Radix + radix_digit_value(*p);
+        p++;
+        count--;
+    }
+    return result;
+}
+
+// Convierte la racha de `count` dígitos significativos ya medida. Las cotas se calculan en
+// compilación: hasta max_digits - 1 dígitos no hay comprobación, el último dígito posible
+// se compara una vez y con más dígitos es overflow (`end` señala el dígito que desborda).
+// En las bases 2, 4 y 16 el máximo es Radix^max_digits - 1 y no hace falta comparar.
+template<unsigned Radix>
+constexpr Expected<std::uint64_t, ParseError> convert_radix_run(const char* const significant, int count, const char*& end) noexcept {
+    constexpr std::uint64_t limit = 18446744073709551615ULL;
+    constexpr int max_digits = radix_digit_count(limit, Radix);
+    constexpr std::uint64_t head_unit = radix_power(Radix, max_digits - 1);
+    constexpr bool full_width = limit / head_unit == Radix - 1 && limit % head_unit == head_unit - 1;
+
+    if (count < max_digits || (full_width && count == max_digits)) {
+        end = significant + count;
+        return Expected<std::uint64_t, ParseError>(accumulate_radix_digits<Radix>(significant, count));
+    }
+
+    const std::uint64_t head = accumulate_radix_digits<Radix>(significant, max_digits - 1);
+    const std::uint64_t last_digit = radix_digit_value(significant[max_digits - 1]);
+    if (head > limit / Radix || (head == limit / Radix && last_digit > limit % Radix)) {
+        end = significant + max_digits - 1;
+        return make_unexpected(ParseError::Overflow);
+    }
+    if (count > max_digits) {
+        end = significant + max_digits;
+        return make_unexpected(ParseError::Overflow);
+    }
+
+    end = significant + max_digits;
+    return Expected<std::uint64_t, ParseError>(head * Radix + last_digit);
+}
+
+// Versión acotada [first, last) al estilo std::from_chars. Con Radix = 10 es
+// parse_number_simple; en las demás bases los errores y `end` siguen sus mismas reglas.
+template<unsigned Radix>
+constexpr Expected<std::uint64_t, ParseError> parse_number(const char* const first, const char* const last, const char*& end) noexcept {
+    static_assert(Radix >= 2 && Radix <= 36, "parse_number admite bases de 2 a 36");
+    if (Radix == 10) {
+        return parse_number_simple(first, last, end);
+    }
+
+    if (first == last || !is_radix_digit<Radix>(*first)) {
+        end = first;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    const char* significant = first;
+    while (significant != last && *significant == '0') {
+        significant++;
+    }
+    const char* const run_end = radix_digit_run_end<Radix>(significant, last);
+    return convert_radix_run<Radix>(significant, static_cast<int>(run_end - significant), end);
+}
+
+// Versión terminada en '\0' (desde start_index), como parse_number_simple
+template<unsigned Radix>
+constexpr Expected<std::uint64_t, ParseError> parse_number(const char* const str, int start_index, int& end_index) noexcept {
+    static_assert(Radix >= 2 && Radix <= 36, "parse_number admite bases de 2 a 36");
+    if (Radix == 10) {
+        return parse_number_simple(str, start_index, end_index);
+    }
+
+    if (!is_radix_digit<Radix>(str[start_index])) {
+        end_index = start_index;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    int first_significant = start_index;
+    while (str[first_significant] == '0') {
+        first_significant++;
+    }
+    int index = first_significant;
+    while (is_radix_digit<Radix>(str[index])) {
+        index++;
+    }
+
+    const char* end = str + index;
+    const Expected<std::uint64_t, ParseError> result =
+        convert_radix_run<Radix>(str + first_significant, index - first_significant, end);
+    end_index = static_cast<int>(end - str);
+    return result;
+}
+
+template<unsigned Radix>
+struct RadixFieldParser {
+    static constexpr Expected<std::uint64_t, ParseError> parse(const char* first, const char* last, const char*& end) noexcept {
+        return parse_number<Radix>(first, last, end);
+    }
+    static constexpr bool is_digit(char c) noexcept { return is_radix_digit<Radix>(c); }
+};
+
+// Campo completo en [first, last) con las reglas de parse_number_field
+template<unsigned Radix>
+constexpr Expected<std::uint64_t, ParseError> parse_number_field(const char* const first, const char* const last) noexcept {
+    return parse_field<std::uint64_t, RadixFieldParser<Radix>>(first, last);
+}
+
+template<unsigned Radix>
+constexpr Expected<std::uint64_t, ParseFailure> parse_number_field_located(const char* const first, const char* const last) noexcept {
+    return parse_field_located<std::uint64_t, RadixFieldParser<Radix>>(first, last);
+}
+
+#endif // PARSE_RADIX_HPP
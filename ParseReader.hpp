@@ -0,0 +1,362 @@
+#ifndef PARSE_READER_HPP
+#define PARSE_READER_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+#include "ParseIngest.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// XPERIMENT_IO_URING lo define CMake con -DXPERIMENT_WITH_IO_URING=ON si encuentra liburing
+#if !defined(_WIN32) && defined(XPERIMENT_IO_URING) && XPERIMENT_IO_URING
+#include <liburing.h>
+#define XPERIMENT_HAS_IO_URING 1
+#else
+#define XPERIMENT_HAS_IO_URING 0
+#endif
+
+// Lectura de ficheros por bloques con varias lecturas en vuelo: mientras se parsea un
+// bloque el kernel ya está llenando los siguientes. Con io_uring los bloques son buffers
+// registrados (read_fixed); si io_uring no está compilado o el kernel lo rechaza en
+// ejecución se lee con pread, bloque a bloque y sin solapamiento.
+//
+// Cada bloque se entrega en orden y terminado en '\n': la línea partida al final de un
+// bloque se copia delante del siguiente, en una zona reservada de max_line_bytes, así
+// que los parsers por lotes ven líneas completas y contiguas sin copiar el bloque.
+
+struct ReaderOptions {
+    std::size_t block_bytes = 4u << 20;       // Tamaño de cada lectura
+    unsigned depth = 4;                       // Bloques (y lecturas en vuelo)
+    std::size_t max_line_bytes = 64u << 10;   // Línea más larga admitida
+    bool use_io_uring = true;                 // false: pread aunque haya io_uring
+};
+
+class BlockReader {
+public:
+    explicit BlockReader(const char* const path, const ReaderOptions& options = ReaderOptions())
+        : path_(path), options_(options) {
+        if (options_.depth == 0 || options_.block_bytes == 0) {
+            throw std::invalid_argument("BlockReader: depth y block_bytes deben ser mayores que 0");
+        }
+#if defined(_WIN32)
+        file_.handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_.handle == INVALID_HANDLE_VALUE) {
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), path);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_.handle, &size)) {
+            throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), path);
+        }
+        size_ = static_cast<std::uint64_t>(size.QuadPart);
+#else
+        file_.fd = ::open(path, O_RDONLY);
+        if (file_.fd < 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        struct stat info;
+        if (::fstat(file_.fd, &info) != 0) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+        size_ = static_cast<std::uint64_t>(info.st_size);
+#endif
+        // Si algo lanza a partir de aquí, file_ (ya construido) cierra el fichero
+        slot_bytes_ = options_.max_line_bytes + options_.block_bytes;
+        slots_.reset(new char[slot_bytes_ * options_.depth]);
+        pending_.assign(options_.depth, Pending{});
+#if XPERIMENT_HAS_IO_URING
+        // Los iovec se reservan antes de crear el anillo: tras io_uring_queue_init ya no
+        // se lanza y el destructor siempre llega a io_uring_queue_exit
+        std::vector<iovec> buffers(options_.use_io_uring ? options_.depth : 0);
+        // Sin io_uring en el kernel (ENOSYS) o bloqueado (EPERM): pread
+        if (options_.use_io_uring && io_uring_queue_init(options_.depth, &ring_, 0) == 0) {
+            uring_ = true;
+            // Sin memoria bloqueable suficiente (RLIMIT_MEMLOCK) se leen sin registrar
+            for (unsigned i = 0; i < options_.depth; ++i) {
+                buffers[i].iov_base = slot(i);
+                buffers[i].iov_len = slot_bytes_;
+            }
+            registered_ = io_uring_register_buffers(&ring_, buffers.data(), options_.depth) == 0;
+        }
+#endif
+    }
+
+    ~BlockReader() {
+#if XPERIMENT_HAS_IO_URING
+        if (uring_) {
+            // Si consume lanzó quedan lecturas en vuelo sobre los buffers: se esperan
+            for (unsigned i = 0; i < options_.depth; ++i) {
+                while (pending_[i].in_flight && reap() == 0) {
+                }
+            }
+            io_uring_queue_exit(&ring_);
+        }
+#endif
+    }
+
+    BlockReader(const BlockReader&) = delete;
+    BlockReader& operator=(const BlockReader&) = delete;
+
+    bool uses_io_uring() const noexcept { return uring_; }
+    bool uses_registered_buffers() const noexcept { return registered_; }
+    std::uint64_t size() const noexcept { return size_; }
+
+    // Llama a consume(first, last, offset) con bloques de líneas completas en orden de
+    // fichero; offset es la posición de first en el fichero. Solo el último bloque puede
+    // no terminar en '\n'. Lanza std::length_error si una línea no cabe en max_line_bytes.
+    template<typename Consume>
+    void for_each_block(Consume&& consume) {
+        const std::uint64_t blocks = (size_ + options_.block_bytes - 1) / options_.block_bytes;
+        for (std::uint64_t block = 0; block < blocks && block < options_.depth; ++block) {
+            start_read(block);
+        }
+
+        std::size_t carry = 0;  // Bytes de la línea partida, ya copiados delante del bloque
+        for (std::uint64_t block = 0; block < blocks; ++block) {
+            const unsigned index = static_cast<unsigned>(block % options_.depth);
+            char* const data = slot(index) + options_.max_line_bytes;
+            const char* const first = data - carry;
+            const char* const last = data + finish_read(index);
+            const std::uint64_t offset = block * options_.block_bytes - carry;
+
+            if (block + 1 == blocks) {
+                if (first != last) {
+                    consume(first, last, offset);
+                }
+                break;
+            }
+
+            const char* cut = last;
+            while (cut != data && cut[-1] != '\n') {
+                cut--;
+            }
+            if (cut == data) {
+                cut = first;  // Ningún '\n' en el bloque: todo pasa al siguiente
+            }
+            if (cut != first) {
+                consume(first, cut, offset);
+            }
+            carry = static_cast<std::size_t>(last - cut);
+            if (carry > options_.max_line_bytes) {
+                throw std::length_error(std::string(path_) + ": línea más larga que max_line_bytes");
+            }
+            // El siguiente bloque puede estar leyéndose ya, pero solo en su zona de datos
+            const unsigned next = static_cast<unsigned>((block + 1) % options_.depth);
+            std::memmove(slot(next) + options_.max_line_bytes - carry, cut, carry);
+
+            if (block + options_.depth < blocks) {
+                start_read(block + options_.depth);
+            }
+        }
+    }
+
+private:
+    // Fichero abierto (RAII): miembro propio para que se cierre también cuando el
+    // constructor lanza después de abrirlo, y no solo en ~BlockReader
+    struct ReaderFile {
+#if defined(_WIN32)
+        HANDLE handle = INVALID_HANDLE_VALUE;
+
+        ~ReaderFile() {
+            if (handle != INVALID_HANDLE_VALUE) CloseHandle(handle);
+        }
+#else
+        int fd = -1;
+
+        ~ReaderFile() {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+        ReaderFile() = default;
+        ReaderFile(const ReaderFile&) = delete;
+        ReaderFile& operator=(const ReaderFile&) = delete;
+    };
+
+    struct Pending {
+        std::uint64_t offset = 0;
+        std::size_t bytes = 0;
+        std::int64_t result = 0;  // Bytes leídos o -errno (io_uring)
+        bool in_flight = false;
+        bool done = false;
+    };
+
+    char* slot(unsigned index) const noexcept {
+        return slots_.get() + static_cast<std::size_t>(index) * slot_bytes_;
+    }
+
+    // Lectura del bloque en su buffer: con io_uring se envía ya, con pread se hace al
+    // pedir el resultado
+    void start_read(std::uint64_t block) {
+        const unsigned index = static_cast<unsigned>(block % options_.depth);
+        Pending& pending = pending_[index];
+        pending.offset = block * options_.block_bytes;
+        pending.bytes = static_cast<std::size_t>(
+            size_ - pending.offset < options_.block_bytes ? size_ - pending.offset : options_.block_bytes);
+        pending.done = false;
+#if XPERIMENT_HAS_IO_URING
+        if (uring_) {
+            io_uring_sqe* const sqe = io_uring_get_sqe(&ring_);
+            char* const data = slot(index) + options_.max_line_bytes;
+            if (registered_) {
+                io_uring_prep_read_fixed(sqe, file_.fd, data, static_cast<unsigned>(pending.bytes), pending.offset, static_cast<int>(index));
+            } else {
+                io_uring_prep_read(sqe, file_.fd, data, static_cast<unsigned>(pending.bytes), pending.offset);
+            }
+            sqe->user_data = index;
+            const int submitted = io_uring_submit(&ring_);
+            if (submitted < 0) {
+                throw std::system_error(-submitted, std::generic_category(), path_);
+            }
+            pending.in_flight = true;
+        }
+#endif
+    }
+
+#if XPERIMENT_HAS_IO_URING
+    // Recoge una finalización, sea del bloque que sea; 0 o -errno
+    int reap() noexcept {
+        io_uring_cqe* cqe = nullptr;
+        int waited;
+        while ((waited = io_uring_wait_cqe(&ring_, &cqe)) == -EINTR) {
+        }
+        if (waited < 0) {
+            return waited;
+        }
+        Pending& pending = pending_[static_cast<unsigned>(cqe->user_data)];
+        pending.result = cqe->res;
+        pending.in_flight = false;
+        pending.done = true;
+        io_uring_cqe_seen(&ring_, cqe);
+        return 0;
+    }
+#endif
+
+    // Espera el bloque del buffer `index` y devuelve los bytes leídos. Una lectura
+    // corta (señal, fichero que encoge) se completa con pread.
+    std::size_t finish_read(unsigned index) {
+        Pending& pending = pending_[index];
+        char* const data = slot(index) + options_.max_line_bytes;
+        std::size_t read = 0;
+#if XPERIMENT_HAS_IO_URING
+        if (uring_) {
+            while (!pending.done) {
+                const int reaped = reap();
+                if (reaped < 0) {
+                    throw std::system_error(-reaped, std::generic_category(), path_);
+                }
+            }
+            if (pending.result < 0) {
+                throw std::system_error(static_cast<int>(-pending.result), std::generic_category(), path_);
+            }
+            read = static_cast<std::size_t>(pending.result);
+        }
+#endif
+        while (read < pending.bytes) {
+            const std::size_t bytes = read_at(data + read, pending.bytes - read, pending.offset + read);
+            if (bytes == 0) {
+                break;
+            }
+            read += bytes;
+        }
+        return read;
+    }
+
+    // Lectura posicional síncrona: bytes leídos, 0 al final del fichero
+    std::size_t read_at(char* const buffer, std::size_t bytes, std::uint64_t offset) {
+#if defined(_WIN32)
+        OVERLAPPED position{};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD read = 0;
+        const DWORD request = bytes > 0x40000000u ? 0x40000000u : static_cast<DWORD>(bytes);
+        if (!ReadFile(file_.handle, buffer, request, &read, &position)) {
+            const DWORD error = GetLastError();
+            if (error == ERROR_HANDLE_EOF) {
+                return 0;
+            }
+            throw std::system_error(static_cast<int>(error), std::system_category(), path_);
+        }
+        return read;
+#else
+        for (;;) {
+            const ssize_t read = ::pread(file_.fd, buffer, bytes, static_cast<off_t>(offset));
+            if (read >= 0) {
+                return static_cast<std::size_t>(read);
+            }
+            if (errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), path_);
+            }
+        }
+#endif
+    }
+
+    const char* path_;
+    ReaderOptions options_;
+    ReaderFile file_;  // Declarado antes que slots_: al lanzar el constructor se cierra tras liberarlos
+    std::uint64_t size_ = 0;
+    std::size_t slot_bytes_ = 0;
+    std::unique_ptr<char[]> slots_;  // depth buffers de max_line_bytes + block_bytes
+    std::vector<Pending> pending_;
+    bool uring_ = false;
+    bool registered_ = false;
+#if XPERIMENT_HAS_IO_URING
+    io_uring ring_;
+#endif
+};
+
+// Lectura y parseo solapados de un fichero de números, uno por línea. Mismo resultado
+// que ingest_number_file; lanza std::system_error si no se puede leer.
+inline NumberIngestResult read_number_file(const char* const path, const ReaderOptions& options = ReaderOptions()) {
+    BlockReader reader(path, options);
+    NumberIngestResult result;
+    reader.for_each_block([&](const char* first, const char* last, std::uint64_t offset) {
+        const std::size_t line = result.values.size();
+        const std::size_t lines = count_lines(first, last);
+        const std::size_t error = result.errors.size();
+        result.values.resize(line + lines);
+        parse_number_lines(first, last, result.values.data() + line, lines, result.errors, line);
+        for (std::size_t i = error; i < result.errors.size(); ++i) {
+            result.errors[i].offset += offset;
+        }
+    });
+    return result;
+}
+
+// Lo mismo para literales "d#N#BM" / "dig[N]BM", uno por línea
+inline DigitIngestResult read_digit_file(const char* const path, const ReaderOptions& options = ReaderOptions()) {
+    BlockReader reader(path, options);
+    DigitIngestResult result;
+    reader.for_each_block([&](const char* first, const char* last, std::uint64_t offset) {
+        const std::size_t line = result.digits.size();
+        const std::size_t lines = count_lines(first, last);
+        const std::size_t error = result.errors.size();
+        result.digits.resize(line + lines);
+        result.bases.resize(line + lines);
+        parse_digit_lines(first, last, result.digits.data() + line, result.bases.data() + line, lines, result.errors, line);
+        for (std::size_t i = error; i < result.errors.size(); ++i) {
+            result.errors[i].offset += offset;
+        }
+    });
+    return result;
+}
+
+#endif // PARSE_READER_HPP
@@ -0,0 +1,251 @@
+#ifndef PARSE_SEPARATOR_HPP
+#define PARSE_SEPARATOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+#include "ParseSimd.hpp"
+
+// Números con separadores de grupos ("1_000_000", "1'000'000"), opcional: el separador
+// es un parámetro de plantilla y solo lo aceptan las funciones de esta cabecera.
+// Un separador debe ir entre dos dígitos; al principio, al final o repetido es
+// MisplacedSeparator con `end` en el separador. Los grupos pueden tener cualquier
+// tamaño. Los separadores se comprueban en toda la racha antes que el overflow.
+//
+// En ejecución los separadores se quitan por bloques de 16 bytes: máscaras de dígitos y
+// separadores, y un pshufb que empaqueta a la izquierda los dígitos de cada mitad
+// (tabla de 256 máscaras). Los dígitos compactos van al conversor SSE4.1 de ParseSimd.
+
+// Valor de los `count` dígitos significativos ya compactados en `digits` (se guardan como
+// mucho los 20 primeros). twentieth / twenty_first son las posiciones originales de los
+// dígitos significativos 20 y 21: el overflow los señala igual que parse_number_simple.
+constexpr Expected<std::uint64_t, ParseError> convert_separated_digits(const char* const digits, int count, const char* const run_end,
+                                                                       const char* const twentieth, const char* const twenty_first,
+                                                                       const char*& end) noexcept {
+    if (count > max_uint64_digits || (count == max_uint64_digits && !fits_uint64_20_digits(digits))) {
+        end = fits_uint64_20_digits(digits) ? twenty_first : twentieth;
+        return make_unexpected(ParseError::Overflow);
+    }
+    end = run_end;
+    return Expected<std::uint64_t, ParseError>(accumulate_digits(digits, count));
+}
+
+// Versión de referencia, constexpr: un carácter por paso, copiando los dígitos
+// significativos a un buffer local
+template<char Separator>
+constexpr Expected<std::uint64_t, ParseError> parse_number_separated_simple(const char* const first, const char* const last, const char*& end) noexcept {
+    static_assert((Separator < '0' || Separator > '9') && Separator != ' ' && Separator != '\t' &&
+                  Separator != '\n' && Separator != '\r', "El separador no puede ser un dígito ni un blanco");
+
+    if (first == last || (*first < '0' || *first > '9')) {
+        end = first;
+        return make_unexpected(first != last && *first == Separator ? ParseError::MisplacedSeparator : ParseError::InvalidCharacter);
+    }
+
+    char digits[max_uint64_digits] = {};
+    int count = 0;
+    const char* twentieth = nullptr;
+    const char* twenty_first = nullptr;
+    const char* p = first;
+    while (p != last) {
+        if (*p >= '0' && *p <= '9') {
+            if (count != 0 || *p != '0') {
+                if (count < max_uint64_digits) {
+                    digits[count] = *p;
+                }
+                count++;
+                if (count == max_uint64_digits) {
+                    twentieth = p;
+                } else if (count == max_uint64_digits + 1) {
+                    twenty_first = p;
+                }
+            }
+        } else if (*p == Separator) {
+            if (last - p < 2 || p[1] < '0' || p[1] > '9') {
+                end = p;
+                return make_unexpected(ParseError::MisplacedSeparator);
+            }
+        } else {
+            break;
+        }
+        p++;
+    }
+    return convert_separated_digits(digits, count, p, twentieth, twenty_first, end);
+}
+
+#if XPERIMENT_X86
+
+// pshufb que empaqueta a la izquierda los carriles marcados de 8 bytes: índices de los
+// bits a 1 de la máscara y 0x80 (carril a cero) en el resto
+struct LeftPackTable {
+    std::uint64_t shuffles[256];
+    unsigned char counts[256];
+};
+
+constexpr LeftPackTable make_left_pack_table() noexcept {
+    LeftPackTable table{};
+    for (int mask = 0; mask < 256; ++mask) {
+        std::uint64_t shuffle = 0x8080808080808080ULL;
+        int count = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if ((mask & (1 << lane)) != 0) {
+                shuffle &= ~(std::uint64_t(0xFF) << (8 * count));
+                shuffle |= std::uint64_t(lane) << (8 * count);
+                count++;
+            }
+        }
+        table.shuffles[mask] = shuffle;
+        table.counts[mask] = static_cast<unsigned char>(count);
+    }
+    return table;
+}
+
+template<typename Unused = void>
+struct LeftPack {
+    static constexpr LeftPackTable table = make_left_pack_table();
+};
+
+template<typename Unused>
+constexpr LeftPackTable LeftPack<Unused>::table;
+
+// Núcleo SSE4.1. Los casos raros (error al principio, más de 48 dígitos, carga que
+// cruzaría de página, overflow) se delegan en la referencia para obtener su `end` exacto.
+template<char Separator>
+XPERIMENT_TARGET("sse4.1") XPERIMENT_NO_ASAN
+inline Expected<std::uint64_t, ParseError> parse_number_separated_sse41(const char* const first, const char* const last, const char*& end) noexcept {
+    const int capacity = 48;
+    if (first == last || *first < '0' || *first > '9') {
+        return parse_number_separated_simple<Separator>(first, last, end);
+    }
+
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i separator = _mm_set1_epi8(Separator);
+    const __m128i high_lanes = _mm_set1_epi8(8);
+    const LeftPackTable& pack = LeftPack<>::table;
+
+    char compact[capacity + 16];
+    int count = 0;
+    bool pending_separator = false;  // El bloque anterior terminó en separador
+    const char* p = first;
+    while (p != last) {
+        if (count > capacity - 16 || !load_stays_in_page(p, 16)) {
+            return parse_number_separated_simple<Separator>(first, last, end);
+        }
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i t = _mm_sub_epi8(v, zero_char);
+        const std::ptrdiff_t remaining = last - p;
+        const std::uint32_t in_range = remaining >= 16 ? 0xFFFFu : (1u << remaining) - 1;
+        std::uint32_t digit = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(t, nine), t))) & in_range;
+        std::uint32_t sep = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, separator))) & in_range;
+
+        // La racha termina en el primer byte que no es dígito ni separador (o en last)
+        const int length = count_trailing_zeros((~(digit | sep) & 0xFFFFu) | 0x10000u);
+        const std::uint32_t in_run = (1u << length) - 1;
+        digit &= in_run;
+        sep &= in_run;
+
+        // Todo separador necesita un dígito detrás; el del último carril lo decide el
+        // bloque siguiente
+        if (pending_separator && (digit & 1u) == 0) {
+            end = p - 1;
+            return make_unexpected(ParseError::MisplacedSeparator);
+        }
+        const std::uint32_t misplaced = sep & ~(digit >> 1) & (length == 16 ? 0x7FFFu : in_run);
+        if (misplaced != 0) {
+            end = p + count_trailing_zeros(misplaced);
+            return make_unexpected(ParseError::MisplacedSeparator);
+        }
+        pending_separator = length == 16 && (sep & 0x8000u) != 0;
+
+        // Empaquetado: cada mitad de 8 bytes con su entrada de la tabla
+        const std::uint32_t low = digit & 0xFFu;
+        const std::uint32_t high = digit >> 8;
+        const __m128i shuffle = _mm_add_epi8(
+            _mm_set_epi64x(static_cast<long long>(pack.shuffles[high]), static_cast<long long>(pack.shuffles[low])),
+            _mm_unpacklo_epi64(_mm_setzero_si128(), high_lanes));
+        const __m128i packed = _mm_shuffle_epi8(v, shuffle);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(compact + count), packed);
+        count += pack.counts[low];
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(compact + count), _mm_unpackhi_epi64(packed, packed));
+        count += pack.counts[high];
+
+        p += length;
+        if (length != 16) {
+            break;
+        }
+    }
+    if (pending_separator) {
+        end = p - 1;
+        return make_unexpected(ParseError::MisplacedSeparator);
+    }
+
+    int first_significant = 0;
+    while (first_significant != count && compact[first_significant] == '0') {
+        first_significant++;
+    }
+    const int significant = count - first_significant;
+    if (significant > max_uint64_digits ||
+        (significant == max_uint64_digits && !fits_uint64_20_digits(compact + first_significant))) {
+        return parse_number_separated_simple<Separator>(first, last, end);
+    }
+    end = p;
+    return Expected<std::uint64_t, ParseError>(convert_digits_sse41(compact + first_significant, significant));
+}
+
+#endif // XPERIMENT_X86
+
+// Camino escalar con la firma de los núcleos
+template<char Separator>
+inline Expected<std::uint64_t, ParseError> parse_number_separated_scalar(const char* const first, const char* const last, const char*& end) noexcept {
+    return parse_number_separated_simple<Separator>(first, last, end);
+}
+
+// Equivalente en tiempo de ejecución de parse_number_separated_simple con el mejor núcleo
+// de la CPU, elegido en la primera llamada
+template<char Separator>
+inline Expected<std::uint64_t, ParseError> parse_number_separated_fast(const char* const first, const char* const last, const char*& end) noexcept {
+    using Kernel = Expected<std::uint64_t, ParseError> (*)(const char*, const char*, const char*&);
+#if XPERIMENT_X86
+    static const Kernel kernel = simd_level() != SimdLevel::Scalar
+        ? &parse_number_separated_sse41<Separator>
+        : &parse_number_separated_scalar<Separator>;
+#else
+    static const Kernel kernel = &parse_number_separated_scalar<Separator>;
+#endif
+    return kernel(first, last, end);
+}
+
+// Punto de entrada: la referencia en compilación y el núcleo SIMD en ejecución
+template<char Separator>
+constexpr Expected<std::uint64_t, ParseError> parse_number_separated(const char* const first, const char* const last, const char*& end) noexcept {
+#if XPERIMENT_X86
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED()) {
+        return parse_number_separated_fast<Separator>(first, last, end);
+    }
+#endif
+    return parse_number_separated_simple<Separator>(first, last, end);
+}
+
+template<char Separator>
+struct SeparatedFieldParser {
+    static constexpr Expected<std::uint64_t, ParseError> parse(const char* first, const char* last, const char*& end) noexcept {
+        return parse_number_separated<Separator>(first, last, end);
+    }
+    static constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+};
+
+// Campo completo en [first, last) con las reglas de parse_number_field
+template<char Separator>
+constexpr Expected<std::uint64_t, ParseError> parse_number_separated_field(const char* const first, const char* const last) noexcept {
+    return parse_field<std::uint64_t, SeparatedFieldParser<Separator>>(first, last);
+}
+
+template<char Separator>
+constexpr Expected<std::uint64_t, ParseFailure> parse_number_separated_field_located(const char* const first, const char* const last) noexcept {
+    return parse_field_located<std::uint64_t, SeparatedFieldParser<Separator>>(first, last);
+}
+
+#endif // PARSE_SEPARATOR_HPP
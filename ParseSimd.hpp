@@ -0,0 +1,258 @@
+#ifndef PARSE_SIMD_HPP
+#define PARSE_SIMD_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+
+// Núcleos SSE4.1/AVX2 para parse_number_simple con selección por cpuid en tiempo de
+// ejecución. Las versiones constexpr de ParseError.hpp siguen siendo la referencia y el
+// camino usado en compilación y en plataformas que no son x86.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define XPERIMENT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define XPERIMENT_TARGET(isa)
+#else
+#include <cpuid.h>
+#define XPERIMENT_TARGET(isa) __attribute__((target(isa)))
+#endif
+#else
+#define XPERIMENT_X86 0
+#endif
+
+enum class SimdLevel {
+    Scalar,  // Sin SIMD: se usa parse_number_simple tal cual
+    Sse41,   // Vectores de 16 bytes
+    Avx2     // Vectores de 32 bytes para clasificar, 16 para convertir
+};
+
+// Consulta cpuid (y xgetbv para saber si el SO guarda los registros YMM)
+inline SimdLevel detect_simd_level() noexcept {
+#if XPERIMENT_X86
+    unsigned int regs[4] = {0, 0, 0, 0};
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const unsigned int max_leaf = static_cast<unsigned int>(info[0]);
+    __cpuid(info, 1);
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned int>(info[i]);
+#else
+    const unsigned int max_leaf = __get_cpuid_max(0, nullptr);
+    __get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+    const bool sse41 = (regs[2] & (1u << 19)) != 0;
+    const bool osxsave = (regs[2] & (1u << 27)) != 0;
+    const bool avx = (regs[2] & (1u << 28)) != 0;
+    if (!sse41) {
+        return SimdLevel::Scalar;
+    }
+
+    bool ymm_enabled = false;
+    if (osxsave && avx) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        ymm_enabled = (_xgetbv(0) & 0x6) == 0x6;
+#else
+        unsigned int xcr0_lo = 0, xcr0_hi = 0;
+        __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        ymm_enabled = (xcr0_lo & 0x6) == 0x6;
+#endif
+    }
+
+    bool avx2 = false;
+    if (ymm_enabled && max_leaf >= 7) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        __cpuidex(info, 7, 0);
+        avx2 = (static_cast<unsigned int>(info[1]) & (1u << 5)) != 0;
+#else
+        unsigned int a = 0, b = 0, c = 0, d = 0;
+        __cpuid_count(7, 0, a, b, c, d);
+        avx2 = (b & (1u << 5)) != 0;
+#endif
+    }
+    return avx2 ? SimdLevel::Avx2 : SimdLevel::Sse41;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Nivel detectado una sola vez por proceso
+inline SimdLevel simd_level() noexcept {
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+#if XPERIMENT_X86
+
+// Índice del bit menos significativo a 1 (mask != 0)
+inline int count_trailing_zeros(std::uint32_t mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Las cadenas son terminadas en '\0' y no conocemos su longitud: una carga de N bytes
+// solo se hace si no cruza de página, igual que strlen. Puede leer más allá del '\0'
+// pero nunca toca una página que no contenga bytes de la cadena.
+inline bool load_stays_in_page(const char* const p, std::size_t bytes) noexcept {
+    return (reinterpret_cast<std::uintptr_t>(p) & 4095u) <= 4096u - bytes;
+}
+
+// Máscara de pshufb que alinea `count` dígitos a la derecha del registro y pone a
+// cero los carriles sobrantes (que actúan como ceros a la izquierda)
+inline const signed char* right_align_shuffle(int count) noexcept {
+    static const signed char table[32] = {
+        -128, -128, -128, -128, -128, -128, -128, -128,
+        -128, -128, -128, -128, -128, -128, -128, -128,
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    return table + count;
+}
+
+// Convierte 16 dígitos ya restados de '0' (byte 0 = el más significativo) con sumas
+// horizontales: pmaddubsw (pares), pmaddwd (grupos de 4), packusdw y pmaddwd (grupos de 8)
+XPERIMENT_TARGET("sse4.1")
+inline std::uint64_t convert_sixteen_digits_sse41(__m128i digits) noexcept {
+    const __m128i mul_1_10 = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1);
+    const __m128i mul_1_100 = _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1);
+    const __m128i mul_1_10000 = _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1);
+
+    __m128i t = _mm_maddubs_epi16(digits, mul_1_10);
+    t = _mm_madd_epi16(t, mul_1_100);
+    t = _mm_packus_epi32(t, t);
+    t = _mm_madd_epi16(t, mul_1_10000);
+
+    const std::uint64_t high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(t));
+    const std::uint64_t low = static_cast<std::uint32_t>(_mm_extract_epi32(t, 1));
+    return high * 100000000ULL + low;
+}
+
+// Convierte `count` (<= 20) dígitos validados que caben en un uint64_t
+XPERIMENT_TARGET("sse4.1") XPERIMENT_NO_ASAN
+inline std::uint64_t convert_digits_sse41(const char* const p, int count) noexcept {
+    const __m128i zero_char = _mm_set1_epi8('0');
+    if (count > 16) {
+        // Los 16 últimos son dígitos, así que la carga está dentro de la cadena
+        const int lead = count - 16;
+        const std::uint64_t head = accumulate_digits(p, lead);
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + lead));
+        return head * 10000000000000000ULL + convert_sixteen_digits_sse41(_mm_sub_epi8(v, zero_char));
+    }
+    if (count == 0 || !load_stays_in_page(p, 16)) {
+        return accumulate_digits(p, count);
+    }
+    const __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), zero_char);
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right_align_shuffle(count)));
+    return convert_sixteen_digits_sse41(_mm_shuffle_epi8(v, shuffle));
+}
+
+// Longitud de la racha de dígitos que empieza en p: clasificación + movemask + tzcnt
+XPERIMENT_TARGET("sse4.1") XPERIMENT_NO_ASAN
+inline int digit_run_length_sse41(const char* const p) noexcept {
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    int n = 0;
+    for (;;) {
+        if (!load_stays_in_page(p + n, 16)) {
+            if (p[n] < '0' || p[n] > '9') {
+                return n;
+            }
+            n++;
+            continue;
+        }
+        const __m128i t = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + n)), zero_char);
+        const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(t, nine), t);
+        const std::uint32_t non_digit = ~static_cast<std::uint32_t>(_mm_movemask_epi8(is_digit)) & 0xFFFFu;
+        if (non_digit != 0) {
+            return n + count_trailing_zeros(non_digit);
+        }
+        n += 16;
+    }
+}
+
+XPERIMENT_TARGET("avx2") XPERIMENT_NO_ASAN
+inline int digit_run_length_avx2(const char* const p) noexcept {
+    const __m256i zero_char = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    int n = 0;
+    for (;;) {
+        if (!load_stays_in_page(p + n, 32)) {
+            if (p[n] < '0' || p[n] > '9') {
+                return n;
+            }
+            n++;
+            continue;
+        }
+        const __m256i t = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + n)), zero_char);
+        const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(t, nine), t);
+        const std::uint32_t non_digit = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(is_digit));
+        if (non_digit != 0) {
+            return n + count_trailing_zeros(non_digit);
+        }
+        n += 32;
+    }
+}
+
+// Misma semántica (valor, error y end_index) que parse_number_simple; solo cambia
+// cómo se mide la racha de dígitos y cómo se convierte
+template<int (*RunLength)(const char*)>
+inline Expected<std::uint64_t, ParseError> parse_number_vectorized(const char* const str, int start_index, int& end_index) noexcept {
+    if (str[start_index] < '0' || str[start_index] > '9') {
+        end_index = start_index;
+        return make_unexpected(ParseError::InvalidCharacter);
+    }
+
+    int first_significant = start_index;
+    while (str[first_significant] == '0') {
+        first_significant++;
+    }
+
+    const int significant = RunLength(str + first_significant);
+    if (significant > max_uint64_digits ||
+        (significant == max_uint64_digits && !fits_uint64_20_digits(str + first_significant))) {
+        end_index = first_significant + (fits_uint64_20_digits(str + first_significant) ? 20 : 19);
+        return make_unexpected(ParseError::Overflow);
+    }
+
+    end_index = first_significant + significant;
+    return Expected<std::uint64_t, ParseError>(convert_digits_sse41(str + first_significant, significant));
+}
+
+#endif // XPERIMENT_X86
+
+// Camino escalar con la firma de los núcleos (no constexpr, para poder tomar su dirección)
+inline Expected<std::uint64_t, ParseError> parse_number_scalar(const char* const str, int start_index, int& end_index) noexcept {
+    return parse_number_simple(str, start_index, end_index);
+}
+
+using ParseNumberKernel = Expected<std::uint64_t, ParseError> (*)(const char*, int, int&);
+
+inline ParseNumberKernel select_parse_number_kernel(SimdLevel level) noexcept {
+#if XPERIMENT_X86
+    switch (level) {
+    case SimdLevel::Avx2: return &parse_number_vectorized<digit_run_length_avx2>;
+    case SimdLevel::Sse41: return &parse_number_vectorized<digit_run_length_sse41>;
+    case SimdLevel::Scalar: break;
+    }
+#else
+    (void)level;
+#endif
+    return &parse_number_scalar;
+}
+
+// Equivalente en tiempo de ejecución de parse_number_simple con el mejor núcleo de la CPU.
+// El núcleo se elige una sola vez, en la primera llamada.
+inline Expected<std::uint64_t, ParseError> parse_number_fast(const char* const str, int start_index, int& end_index) noexcept {
+    static const ParseNumberKernel kernel = select_parse_number_kernel(simd_level());
+    return kernel(str, start_index, end_index);
+}
+
+#endif // PARSE_SIMD_HPP
@@ -0,0 +1,319 @@
+#ifndef PARSE_STREAM_HPP
+#define PARSE_STREAM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+
+// Parsers incrementales para tuberías, sockets y buffers circulares: los registros van
+// separados por '\n' y pueden quedar partidos entre dos llamadas a feed(). El estado
+// (valor acumulado, paso de la gramática, delimitador elegido) se conserva entre
+// llamadas, así que no hace falta reensamblar líneas.
+//
+// Cada registro completo se entrega al sink como sink(línea, Expected<T, ParseError>),
+// con la misma semántica que parse_number_field / parse_digit_format_field. finish()
+// entrega el último registro si el flujo no termina en '\n'.
+
+// Acumula un dígito con la regla por número de dígitos significativos: hasta 19 no hay
+// comprobación, el 20 se compara una vez con el máximo y a partir del 21 es overflow
+inline bool stream_accumulate_digit(std::uint64_t& value, int& significant, unsigned digit) noexcept {
+    if (significant == 0 && digit == 0) {
+        return true;  // Cero a la izquierda
+    }
+    significant++;
+    if (significant < max_uint64_digits ||
+        (significant == max_uint64_digits &&
+         (value < 1844674407370955161ULL || (value == 1844674407370955161ULL && digit <= 5)))) {
+        value = value * 10 + digit;
+        return true;
+    }
+    return false;
+}
+
+inline bool stream_is_blank(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Números decimales, uno por línea
+class NumberStreamParser {
+public:
+    template<typename Sink>
+    void feed(const char* first, const char* const last, Sink&& sink) {
+        while (first != last) {
+            if (state_ == State::Error) {
+                // Ya se conoce el error del registro: saltar hasta el final de línea
+                const void* const newline = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+                if (newline == nullptr) {
+                    return;
+                }
+                first = static_cast<const char*>(newline);
+            }
+
+            const char c = *first++;
+            if (c == '\n') {
+                emit(sink);
+                continue;
+            }
+            pending_ = true;
+
+            switch (state_) {
+            case State::Leading:
+            case State::Digits:
+                if (c >= '0' && c <= '9') {
+                    state_ = State::Digits;
+                    push_digit(c);
+                    // Bucle interno mientras siguen llegando dígitos
+                    while (first != last && *first >= '0' && *first <= '9' && state_ == State::Digits) {
+                        push_digit(*first++);
+                    }
+                } else if (stream_is_blank(c)) {
+                    state_ = (state_ == State::Digits) ? State::Trailing : State::Leading;
+                } else {
+                    fail(ParseError::InvalidCharacter);
+                }
+                break;
+            case State::Trailing:
+                if (c >= '0' && c <= '9') {
+                    fail(ParseError::BlankInterDigits);
+                } else if (!stream_is_blank(c)) {
+                    fail(ParseError::InvalidCharacter);
+                }
+                break;
+            case State::Error:
+                break;
+            }
+        }
+    }
+
+    template<typename Sink>
+    void finish(Sink&& sink) {
+        if (pending_) {
+            emit(sink);
+        }
+    }
+
+    std::uint64_t line() const noexcept { return line_; }
+
+private:
+    enum class State { Leading, Digits, Trailing, Error };
+
+    void push_digit(char c) noexcept {
+        if (!stream_accumulate_digit(value_, significant_, static_cast<unsigned>(c - '0'))) {
+            fail(ParseError::Overflow);
+        }
+    }
+
+    void fail(ParseError error) noexcept {
+        state_ = State::Error;
+        error_ = error;
+    }
+
+    template<typename Sink>
+    void emit(Sink& sink) {
+        if (state_ == State::Digits || state_ == State::Trailing) {
+            sink(line_, Expected<std::uint64_t, ParseError>(value_));
+        } else {
+            sink(line_, Expected<std::uint64_t, ParseError>(
+                make_unexpected(state_ == State::Error ? error_ : ParseError::Empty)));
+        }
+        line_++;
+        state_ = State::Leading;
+        value_ = 0;
+        significant_ = 0;
+        pending_ = false;
+    }
+
+    State state_ = State::Leading;
+    ParseError error_ = ParseError::UnknownError;
+    std::uint64_t value_ = 0;
+    int significant_ = 0;
+    bool pending_ = false;  // Hay bytes de un registro aún sin terminar
+    std::uint64_t line_ = 0;
+};
+
+// Literales "d#N#BM" / "dig[N]BM", uno por línea
+class DigitStreamParser {
+public:
+    template<typename Sink>
+    void feed(const char* first, const char* const last, Sink&& sink) {
+        while (first != last) {
+            if (step_ == Step::Error) {
+                const void* const newline = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+                if (newline == nullptr) {
+                    return;
+                }
+                first = static_cast<const char*>(newline);
+            }
+
+            const char c = *first++;
+            if (c == '\n') {
+                emit(sink);
+            } else {
+                step(c);
+            }
+        }
+    }
+
+    template<typename Sink>
+    void finish(Sink&& sink) {
+        if (step_ != Step::Prefix) {
+            emit(sink);
+        }
+    }
+
+    std::uint64_t line() const noexcept { return line_; }
+
+private:
+    // Pasos de la gramática de parse_digit_format_simple
+    enum class Step {
+        Prefix,          // 1. "d"
+        PrefixI,         //    "i" opcional de "dig"
+        PrefixG,         //    "g" de "dig"
+        OpenDelimiter,   // 2-3. blancos y "#" | "["
+        DigitStart,      // 4-5. blancos y primer dígito
+        Digit,           //      resto de dígitos
+        CloseDelimiter,  // 6-7. blancos y delimitador de cierre
+        LetterB,         // 8-9. blancos y "B"
+        BaseStart,       // 10-11. blancos y primer dígito de la base
+        Base,            //        resto de la base
+        Trailing,        // 13. blancos finales
+        Error
+    };
+
+    static bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+    void fail(ParseError error) noexcept {
+        step_ = Step::Error;
+        error_ = error;
+    }
+
+    // Avanza un carácter; el fin de registro se trata como el '\0' de la versión original
+    void step(char c) noexcept {
+        switch (step_) {
+        case Step::Prefix:
+            if (c == 'd') {
+                step_ = Step::PrefixI;
+            } else {
+                fail(c == '\0' ? ParseError::Empty : ParseError::InvalidPrefix);
+            }
+            break;
+        case Step::PrefixI:
+            if (c == 'i') {
+                step_ = Step::PrefixG;
+            } else {
+                step_ = Step::OpenDelimiter;
+                step(c);
+            }
+            break;
+        case Step::PrefixG:
+            // "di" sin "g": la 'i' no es un delimitador
+            if (c == 'g') {
+                step_ = Step::OpenDelimiter;
+            } else {
+                fail(ParseError::MissingDelimiter);
+            }
+            break;
+        case Step::OpenDelimiter:
+            if (c == '#' || c == '[') {
+                closing_ = (c == '#') ? '#' : ']';
+                step_ = Step::DigitStart;
+            } else if (!stream_is_blank(c)) {
+                fail(ParseError::MissingDelimiter);
+            }
+            break;
+        case Step::DigitStart:
+            if (is_digit(c)) {
+                step_ = Step::Digit;
+                step(c);
+            } else if (!stream_is_blank(c)) {
+                fail(ParseError::InvalidDigit);
+            }
+            break;
+        case Step::Digit:
+            if (is_digit(c)) {
+                if (!stream_accumulate_digit(digit_, significant_, static_cast<unsigned>(c - '0'))) {
+                    fail(ParseError::Overflow);
+                }
+            } else {
+                significant_ = 0;
+                step_ = Step::CloseDelimiter;
+                step(c);
+            }
+            break;
+        case Step::CloseDelimiter:
+            if (c == closing_) {
+                step_ = Step::LetterB;
+            } else if (!stream_is_blank(c)) {
+                fail(ParseError::MismatchedDelimiter);
+            }
+            break;
+        case Step::LetterB:
+            if (c == 'B') {
+                step_ = Step::BaseStart;
+            } else if (!stream_is_blank(c)) {
+                fail(ParseError::MissingB);
+            }
+            break;
+        case Step::BaseStart:
+            if (is_digit(c)) {
+                step_ = Step::Base;
+                step(c);
+            } else if (!stream_is_blank(c)) {
+                fail(ParseError::InvalidBase);
+            }
+            break;
+        case Step::Base:
+            if (is_digit(c)) {
+                if (!stream_accumulate_digit(base_, significant_, static_cast<unsigned>(c - '0'))) {
+                    fail(ParseError::Overflow);
+                }
+            } else {
+                // 12. Validar que base-1 <= uint32_max
+                const std::uint64_t uint32_max = 4294967295ULL;
+                if (base_ == 0 || (base_ - 1) > uint32_max) {
+                    fail(ParseError::BaseOutOfRange);
+                } else {
+                    step_ = Step::Trailing;
+                    step(c);
+                }
+            }
+            break;
+        case Step::Trailing:
+            if (c != '\0' && !stream_is_blank(c)) {
+                fail(ParseError::InvalidCharacter);
+            }
+            break;
+        case Step::Error:
+            break;
+        }
+    }
+
+    template<typename Sink>
+    void emit(Sink& sink) {
+        step('\0');
+        if (step_ == Step::Trailing) {
+            sink(line_, Expected<DigitResult, ParseError>(DigitResult(digit_, base_)));
+        } else {
+            sink(line_, Expected<DigitResult, ParseError>(make_unexpected(error_)));
+        }
+        line_++;
+        step_ = Step::Prefix;
+        closing_ = '#';
+        digit_ = 0;
+        base_ = 0;
+        significant_ = 0;
+    }
+
+    Step step_ = Step::Prefix;
+    ParseError error_ = ParseError::UnknownError;
+    char closing_ = '#';
+    std::uint64_t digit_ = 0;
+    std::uint64_t base_ = 0;
+    int significant_ = 0;
+    std::uint64_t line_ = 0;
+};
+
+#endif // PARSE_STREAM_HPP
@@ -0,0 +1,354 @@
+#ifndef PARSE_STRUCTURAL_HPP
+#define PARSE_STRUCTURAL_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+
+// Parser en dos etapas para flujos de literales "d#N#BM" / "dig[N]BM", uno por línea
+// (al estilo de simdjson). La etapa 1 clasifica 64 bytes por paso y guarda un bitmap por
+// clase: dígitos, ceros, blancos, '#', '[', ']', 'B' y '\n'. La etapa 2 recorre cada línea
+// sobre esos bitmaps, sin mirar los caracteres uno a uno: un literal sin blancos de menos
+// de 64 bytes se resuelve con una lectura de cada bitmap y unos pocos ctz; si hay blancos
+// se salta de elemento en elemento. Las conversiones usan el núcleo SWAR.
+//
+// La etapa 2 solo acepta literales bien formados que caben en uint64_t. Cualquier otra
+// línea (error, overflow, base fuera de rango) pasa por parse_digit_line, así que
+// valores, errores y desplazamientos son los de parse_digit_lines.
+
+// Bitmaps de un bloque de 64 bytes: bit i = byte i
+struct DigitBlockMasks {
+    std::uint64_t digit;
+    std::uint64_t zero;
+    std::uint64_t whitespace;
+    std::uint64_t hash;
+    std::uint64_t open_bracket;
+    std::uint64_t close_bracket;
+    std::uint64_t marker;   // 'B'
+    std::uint64_t newline;
+};
+
+// Bloques por ventana: las líneas se indexan por ventanas de 4 KiB
+constexpr std::size_t structural_window_blocks = 64;
+
+// Índice de una ventana, un array por clase para que la etapa 2 recorra cada bitmap
+// como una tira de bits continua. Las dos palabras de más permiten leer 64 bits desde
+// cualquier posición hasta el final de la ventana inclusive; lo que haya más allá del
+// final de la línea no se usa.
+struct DigitStructuralIndex {
+    std::uint64_t digit[structural_window_blocks + 2];
+    std::uint64_t zero[structural_window_blocks + 2];
+    std::uint64_t whitespace[structural_window_blocks + 2];
+    std::uint64_t hash[structural_window_blocks + 2];
+    std::uint64_t open_bracket[structural_window_blocks + 2];
+    std::uint64_t close_bracket[structural_window_blocks + 2];
+    std::uint64_t marker[structural_window_blocks + 2];
+    std::uint64_t newline[structural_window_blocks + 2];
+};
+
+// --- Etapa 1 ---
+
+// Clasificación byte a byte con la tabla de clases (sin SSE2)
+inline DigitBlockMasks classify_digit_block_scalar(const char* const p) noexcept {
+    DigitBlockMasks masks{};
+    for (int i = 0; i < 64; ++i) {
+        const std::uint64_t bit = std::uint64_t(1) << i;
+        const unsigned char c = static_cast<unsigned char>(p[i]);
+        const unsigned char classes = CharClasses<>::table.classes[c];
+        masks.digit |= (classes & char_class_digit) != 0 ? bit : 0;
+        masks.whitespace |= (classes & char_class_whitespace) != 0 ? bit : 0;
+        masks.zero |= c == '0' ? bit : 0;
+        masks.hash |= c == '#' ? bit : 0;
+        masks.open_bracket |= c == '[' ? bit : 0;
+        masks.close_bracket |= c == ']' ? bit : 0;
+        masks.marker |= c == 'B' ? bit : 0;
+        masks.newline |= c == '\n' ? bit : 0;
+    }
+    return masks;
+}
+
+#if XPERIMENT_SSE2
+
+// Máscaras de 64 bytes a partir de las de digit_mask16 / byte_mask32 de ParseError.hpp
+inline std::uint64_t byte_mask64(const __m128i* v, char c) noexcept {
+    return static_cast<std::uint64_t>(byte_mask32(v[0], v[1], c)) | static_cast<std::uint64_t>(byte_mask32(v[2], v[3], c)) << 32;
+}
+
+inline std::uint64_t digit_mask64(const __m128i* v) noexcept {
+    return static_cast<std::uint64_t>(digit_mask16(v[0]) | digit_mask16(v[1]) << 16) |
+           static_cast<std::uint64_t>(digit_mask16(v[2]) | digit_mask16(v[3]) << 16) << 32;
+}
+
+// Los 64 bytes se cargan una vez y se comparan contra cada clase
+inline DigitBlockMasks classify_digit_block(const char* const p) noexcept {
+    const __m128i* const src = reinterpret_cast<const __m128i*>(p);
+    const __m128i v[4] = {_mm_loadu_si128(src), _mm_loadu_si128(src + 1), _mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3)};
+    DigitBlockMasks masks;
+    masks.digit = digit_mask64(v);
+    masks.zero = byte_mask64(v, '0');
+    masks.newline = byte_mask64(v, '\n');
+    masks.whitespace = byte_mask64(v, ' ') | byte_mask64(v, '\t') | byte_mask64(v, '\r') | masks.newline;
+    masks.hash = byte_mask64(v, '#');
+    masks.open_bracket = byte_mask64(v, '[');
+    masks.close_bracket = byte_mask64(v, ']');
+    masks.marker = byte_mask64(v, 'B');
+    return masks;
+}
+
+#else
+
+inline DigitBlockMasks classify_digit_block(const char* const p) noexcept {
+    return classify_digit_block_scalar(p);
+}
+
+#endif // XPERIMENT_SSE2
+
+// Indexa los `bytes` (<= 64 * structural_window_blocks) bytes de la ventana. El último
+// bloque incompleto se copia a un bloque relleno con '\0', que no pertenece a ninguna clase.
+inline void index_digit_window(const char* const window, std::size_t bytes, DigitStructuralIndex& index) noexcept {
+    for (std::size_t block = 0; block * 64 < bytes; ++block) {
+        const std::size_t available = bytes - block * 64;
+        DigitBlockMasks masks;
+        if (available >= 64) {
+            masks = classify_digit_block(window + block * 64);
+        } else {
+            char padded[64] = {};
+            std::memcpy(padded, window + block * 64, available);
+            masks = classify_digit_block(padded);
+        }
+        index.digit[block] = masks.digit;
+        index.zero[block] = masks.zero;
+        index.whitespace[block] = masks.whitespace;
+        index.hash[block] = masks.hash;
+        index.open_bracket[block] = masks.open_bracket;
+        index.close_bracket[block] = masks.close_bracket;
+        index.marker[block] = masks.marker;
+        index.newline[block] = masks.newline;
+    }
+}
+
+// --- Etapa 2 ---
+
+inline bool index_bit(const std::uint64_t* const bits, std::size_t pos) noexcept {
+    return ((bits[pos / 64] >> (pos % 64)) & 1u) != 0;
+}
+
+// Los 64 bits de la tira que empiezan en pos, sin saltos según pos % 64
+inline std::uint64_t bits_at(const std::uint64_t* const bits, std::size_t pos) noexcept {
+    const unsigned shift = static_cast<unsigned>(pos % 64);
+    return (bits[pos / 64] >> shift) | ((bits[pos / 64 + 1] << 1) << (63 - shift));
+}
+
+// Primera posición >= pos con el bit a 0, o `limit` si no la hay antes. Casi siempre
+// basta un ctz; las rachas de 64 o más se recorren por palabras.
+inline std::size_t next_clear_bit(const std::uint64_t* const bits, std::size_t pos, std::size_t limit) noexcept {
+    const std::uint64_t clear = ~bits_at(bits, pos);
+    if (clear != 0) {
+        const std::size_t found = pos + static_cast<std::size_t>(count_trailing_zeros64(clear));
+        return found < limit ? found : limit;
+    }
+    for (pos += 64; pos < limit; pos += 64) {
+        const std::uint64_t rest = ~bits_at(bits, pos);
+        if (rest != 0) {
+            const std::size_t found = pos + static_cast<std::size_t>(count_trailing_zeros64(rest));
+            return found < limit ? found : limit;
+        }
+    }
+    return limit;
+}
+
+// Convierte la racha de dígitos [first, last) de la ventana; false si no cabe en
+// uint64_t. readable = bytes legibles desde el inicio de la ventana: los últimos dígitos
+// (menos de 8) se convierten con una carga de 8 bytes desplazada, como en
+// parse_number_simple, cuando hay sitio para leerla.
+inline bool convert_indexed_digits(const DigitStructuralIndex& index, const char* const window, std::size_t readable,
+                                   std::size_t first, std::size_t last, std::uint64_t& value) noexcept {
+    // Con 19 dígitos o menos no hay overflow posible y los ceros a la izquierda no
+    // cambian el valor: solo las rachas largas necesitan saltarlos
+    std::size_t significant = first;
+    if (last - first >= static_cast<std::size_t>(max_uint64_digits)) {
+        significant = next_clear_bit(index.zero, first, last);
+    }
+    std::size_t count = last - significant;
+    if (count > static_cast<std::size_t>(max_uint64_digits) ||
+        (count == static_cast<std::size_t>(max_uint64_digits) && !fits_uint64_20_digits(window + significant))) {
+        return false;
+    }
+    const char* p = window + significant;
+    std::uint64_t result = 0;
+    while (count >= 8) {
+        result = result * 100000000ULL + swar_parse_eight_digits(swar_load8(p));
+        p += 8;
+        count -= 8;
+    }
+    if (count != 0) {
+        if (readable - static_cast<std::size_t>(p - window) >= 8) {
+            const int digits = static_cast<int>(count);
+            result = result * power_of_ten(digits) + swar_parse_eight_digits(swar_load8(p) << (8 * (8 - digits)));
+        } else {
+            result = result * power_of_ten(static_cast<int>(count)) + accumulate_digits(p, static_cast<int>(count));
+        }
+    }
+    value = result;
+    return true;
+}
+
+// Caso habitual: literal sin blancos de menos de 64 bytes. Los bitmaps de la línea se
+// leen una vez y las posiciones salen de desplazamientos y ctz en registros, sin la
+// cadena de cargas dependientes de un recorrido elemento a elemento.
+inline bool parse_compact_digit_line(const DigitStructuralIndex& index, const char* const window, std::size_t readable,
+                                     std::size_t first, std::size_t last,
+                                     std::uint64_t& digit, std::uint64_t& base) noexcept {
+    const unsigned length = static_cast<unsigned>(last - first);
+    const std::uint64_t in_line = (std::uint64_t(1) << length) - 1;
+    if ((bits_at(index.whitespace, first) & in_line) != 0) {
+        return false;
+    }
+    const unsigned open = length >= 3 && window[first + 1] == 'i' && window[first + 2] == 'g' ? 3 : 1;
+    const std::uint64_t hash = bits_at(index.hash, first);
+    const std::uint64_t digits = bits_at(index.digit, first) & in_line;
+    const std::uint64_t closing = (hash >> open) & 1u ? hash : bits_at(index.close_bracket, first);
+    if (open >= length || ((hash | bits_at(index.open_bracket, first)) >> open & 1u) == 0) {
+        return false;
+    }
+
+    const unsigned digit_first = open + 1;
+    const unsigned digit_last = digit_first + static_cast<unsigned>(count_trailing_zeros64(~(digits >> digit_first)));
+    const unsigned base_first = digit_last + 2;
+    if (digit_last == digit_first || base_first >= length ||
+        ((closing >> digit_last) & (bits_at(index.marker, first) >> (digit_last + 1)) & 1u) == 0) {
+        return false;
+    }
+    const unsigned base_last = base_first + static_cast<unsigned>(count_trailing_zeros64(~(digits >> base_first)));
+    return base_last == length &&
+           convert_indexed_digits(index, window, readable, first + digit_first, first + digit_last, digit) &&
+           convert_indexed_digits(index, window, readable, first + base_first, first + base_last, base) &&
+           base != 0 && base - 1 <= 4294967295ULL;
+}
+
+// Camino rápido de la línea [first, last) de la ventana (sin '\n' ni '\r' final): true
+// si es un literal válido, con la misma gramática que parse_digit_format_field
+inline bool parse_indexed_digit_line(const DigitStructuralIndex& index, const char* const window, std::size_t readable,
+                                     std::size_t first, std::size_t last,
+                                     std::uint64_t& digit, std::uint64_t& base) noexcept {
+    if (first == last || window[first] != 'd') {
+        return false;
+    }
+    if (last - first < 64 && parse_compact_digit_line(index, window, readable, first, last, digit, base)) {
+        return true;
+    }
+    std::size_t p = first + 1;
+    if (last - p >= 2 && window[p] == 'i' && window[p + 1] == 'g') {
+        p += 2;
+    }
+
+    p = next_clear_bit(index.whitespace, p, last);
+    if (p == last || !(index_bit(index.hash, p) || index_bit(index.open_bracket, p))) {
+        return false;
+    }
+    const std::uint64_t* const closing = index_bit(index.hash, p) ? index.hash : index.close_bracket;
+
+    p = next_clear_bit(index.whitespace, p + 1, last);
+    std::size_t run_end = next_clear_bit(index.digit, p, last);
+    if (run_end == p || !convert_indexed_digits(index, window, readable, p, run_end, digit)) {
+        return false;
+    }
+
+    p = next_clear_bit(index.whitespace, run_end, last);
+    if (p == last || !index_bit(closing, p)) {
+        return false;
+    }
+    p = next_clear_bit(index.whitespace, p + 1, last);
+    if (p == last || !index_bit(index.marker, p)) {
+        return false;
+    }
+
+    p = next_clear_bit(index.whitespace, p + 1, last);
+    run_end = next_clear_bit(index.digit, p, last);
+    if (run_end == p || !convert_indexed_digits(index, window, readable, p, run_end, base)) {
+        return false;
+    }
+    return base != 0 && base - 1 <= 4294967295ULL && next_clear_bit(index.whitespace, run_end, last) == last;
+}
+
+// Misma interfaz y mismo resultado que parse_digit_lines. El buffer se indexa por
+// ventanas que empiezan en inicio de línea; una línea más larga que una ventana se
+// convierte con parse_digit_line.
+//
+// Desde la vía rápida canónica de parse_digit_line la ganancia es pequeña y depende de
+// la máquina (xperiment_bench): de nada a un 8% con literales mezclados, de nada a un
+// 22% con canónicos y de nada a un 14% con blancos entre elementos. Medir antes de
+// sustituir parse_digit_lines.
+inline BatchParseResult parse_digit_lines_indexed(const char* const first, const char* const last,
+                                                  std::uint64_t* const digits, std::uint64_t* const bases,
+                                                  std::size_t capacity, std::vector<LineError>& errors,
+                                                  std::uint64_t first_line = 0) {
+    DigitStructuralIndex index{};
+    std::size_t count = 0;
+    const char* window = first;
+
+    // Línea [line_first, line_last) de la ventana, sin el '\n'
+    const auto parse_line = [&](std::size_t line_first, std::size_t line_last) {
+        std::size_t content_last = line_last;
+        if (content_last != line_first && window[content_last - 1] == '\r') {
+            content_last--;
+        }
+        if (!parse_indexed_digit_line(index, window, static_cast<std::size_t>(last - window), line_first, content_last,
+                                      digits[count], bases[count])) {
+            parse_digit_line(window + line_first, window + line_last, first, first_line + count,
+                             digits[count], bases[count], errors);
+        }
+        count++;
+    };
+
+    while (window != last) {
+        const std::size_t available = static_cast<std::size_t>(last - window);
+        const std::size_t bytes = available < 64 * structural_window_blocks ? available : 64 * structural_window_blocks;
+        index_digit_window(window, bytes, index);
+
+        std::size_t line = 0;
+        for (std::size_t block = 0; block * 64 < bytes; ++block) {
+            std::uint64_t mask = index.newline[block];
+            while (mask != 0) {
+                if (count == capacity) {
+                    return BatchParseResult{count, window + line};
+                }
+                const std::size_t newline = block * 64 + static_cast<std::size_t>(count_trailing_zeros64(mask));
+                mask &= mask - 1;
+                parse_line(line, newline);
+                line = newline + 1;
+            }
+        }
+
+        if (bytes == available) {
+            // Última ventana: la línea final puede no terminar en '\n'
+            if (line != bytes) {
+                if (count == capacity) {
+                    return BatchParseResult{count, window + line};
+                }
+                parse_line(line, bytes);
+            }
+            return BatchParseResult{count, last};
+        }
+        if (line == 0) {
+            // Ninguna línea termina en la ventana
+            if (count == capacity) {
+                return BatchParseResult{count, window};
+            }
+            const void* const found = std::memchr(window + bytes, '\n', available - bytes);
+            const char* const newline = found != nullptr ? static_cast<const char*>(found) : last;
+            parse_digit_line(window, newline, first, first_line + count, digits[count], bases[count], errors);
+            count++;
+            window = newline != last ? newline + 1 : last;
+            continue;
+        }
+        window += line;
+    }
+    return BatchParseResult{count, last};
+}
+
+#endif // PARSE_STRUCTURAL_HPP
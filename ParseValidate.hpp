@@ -0,0 +1,216 @@
+#ifndef PARSE_VALIDATE_HPP
+#define PARSE_VALIDATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ParseError.hpp"
+
+// Validación sin conversión: validate_number y validate_digit_format responden si un
+// campo es un número o un literal de dígito bien formado, con exactamente las mismas
+// reglas que parse_number_field y parse_digit_format_simple / parse_digit_format_field,
+// pero sin acumular valores ni construir DigitResult. El overflow se decide comparando
+// los dígitos con el máximo como texto. Para saber qué falla y dónde, *_located.
+//
+// La gramática se recorre una sola vez sobre un cursor de clases de carácter. En
+// compilación el cursor usa la tabla de clases; en ejecución, los campos de menos de 32
+// bytes se clasifican con una pasada SSE2 y cada racha de blancos o dígitos se salta
+// con un ctz.
+
+// ¿Caben en un uint64_t los `count` dígitos que empiezan en p?
+constexpr bool digits_fit_uint64(const char* p, int count) noexcept {
+    while (count > 0 && *p == '0') {
+        p++;
+        count--;
+    }
+    return count < max_uint64_digits || (count == max_uint64_digits && fits_uint64_20_digits(p));
+}
+
+// ¿Es la base de `count` dígitos distinta de 0 y con base - 1 <= uint32_max?
+constexpr bool digits_in_base_range(const char* p, int count) noexcept {
+    while (count > 0 && *p == '0') {
+        p++;
+        count--;
+    }
+    if (count == 0 || count > 10) {
+        return false;
+    }
+    if (count < 10) {
+        return true;
+    }
+    const char* const max_base_str = "4294967296";
+    for (int i = 0; i < 10; ++i) {
+        if (p[i] != max_base_str[i]) {
+            return p[i] < max_base_str[i];
+        }
+    }
+    return true;
+}
+
+// Cursor escalar: clases por tabla, un carácter por paso
+struct ScalarClassCursor {
+    const char* p;
+    int length;
+
+    constexpr int skip_whitespace(int pos) const noexcept {
+        while (pos < length && is_whitespace(p[pos])) {
+            pos++;
+        }
+        return pos;
+    }
+    constexpr int digit_run_end(int pos) const noexcept {
+        while (pos < length && p[pos] >= '0' && p[pos] <= '9') {
+            pos++;
+        }
+        return pos;
+    }
+};
+
+// `ws* digit+ ws*` con el número dentro de uint64_t
+template<typename Cursor>
+constexpr bool validate_number_with(const Cursor& cursor) noexcept {
+    const int digits = cursor.skip_whitespace(0);
+    const int digits_end = cursor.digit_run_end(digits);
+    return digits_end != digits &&
+           cursor.skip_whitespace(digits_end) == cursor.length &&
+           digits_fit_uint64(cursor.p + digits, digits_end - digits);
+}
+
+// Gramática de parse_digit_format_simple: "d" | "dig", "#N#" | "[N]", "B", base, blancos
+// finales; blancos permitidos entre los elementos pero no al principio
+template<typename Cursor>
+constexpr bool validate_digit_format_with(const Cursor& cursor) noexcept {
+    const char* const p = cursor.p;
+    const int length = cursor.length;
+    if (length == 0 || p[0] != 'd') {
+        return false;
+    }
+    int pos = (length >= 3 && p[1] == 'i' && p[2] == 'g') ? 3 : 1;
+
+    pos = cursor.skip_whitespace(pos);
+    if (pos == length || (p[pos] != '#' && p[pos] != '[')) {
+        return false;
+    }
+    const char closing = (p[pos] == '#') ? '#' : ']';
+
+    const int digit = cursor.skip_whitespace(pos + 1);
+    const int digit_end = cursor.digit_run_end(digit);
+    if (digit_end == digit || !digits_fit_uint64(p + digit, digit_end - digit)) {
+        return false;
+    }
+
+    pos = cursor.skip_whitespace(digit_end);
+    if (pos == length || p[pos] != closing) {
+        return false;
+    }
+    pos = cursor.skip_whitespace(pos + 1);
+    if (pos == length || p[pos] != 'B') {
+        return false;
+    }
+
+    const int base = cursor.skip_whitespace(pos + 1);
+    const int base_end = cursor.digit_run_end(base);
+    return base_end != base &&
+           digits_in_base_range(p + base, base_end - base) &&
+           cursor.skip_whitespace(base_end) == length;
+}
+
+#if XPERIMENT_RUNTIME_SIMD
+
+// Cursor sobre máscaras de 32 bits (bit i = byte i) para campos de menos de 32 bytes:
+// las posiciones a partir de length no son ni blanco ni dígito, así que toda racha
+// termina como mucho en length, y el bit 31 siempre está a 0
+struct MaskClassCursor {
+    const char* p;
+    int length;
+    std::uint32_t whitespace;
+    std::uint32_t digit;
+
+    int skip_whitespace(int pos) const noexcept {
+        return pos + lowest_set_bit(~(whitespace >> pos));
+    }
+    int digit_run_end(int pos) const noexcept {
+        return pos + lowest_set_bit(~(digit >> pos));
+    }
+};
+
+// Clasifica los `length` (< 32) bytes de p con dos cargas de 16 bytes. Puede leer hasta
+// 32 bytes, así que el llamador garantiza que no se cruza de página.
+XPERIMENT_NO_ASAN
+inline MaskClassCursor classify_short_field(const char* const p, int length) noexcept {
+    const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+    const __m128i low = _mm_loadu_si128(v);
+    const __m128i high = _mm_loadu_si128(v + 1);
+    const std::uint32_t in_field = (std::uint32_t(1) << length) - 1;
+    return MaskClassCursor{
+        p, length,
+        (whitespace_mask16(low) | (whitespace_mask16(high) << 16)) & in_field,
+        (digit_mask16(low) | (digit_mask16(high) << 16)) & in_field};
+}
+
+// Máscara de los '\0' en los 32 bytes a partir de p (misma condición de página)
+XPERIMENT_NO_ASAN
+inline std::uint32_t nul_mask32(const char* const p) noexcept {
+    const __m128i* const v = reinterpret_cast<const __m128i*>(p);
+    const __m128i zero = _mm_setzero_si128();
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v), zero))) |
+           (static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(v + 1), zero))) << 16);
+}
+
+// ¿Se puede clasificar [p, p + length) de una vez sin salir de la página? Con length 0
+// ni siquiera *p es legible (p puede ser el final de un buffer alineado a página).
+inline bool is_short_field(const char* const p, std::ptrdiff_t length) noexcept {
+    return length > 0 && length < 32 && (reinterpret_cast<std::uintptr_t>(p) & 4095u) <= 4096u - 32;
+}
+
+#endif // XPERIMENT_RUNTIME_SIMD
+
+// Mismo resultado que parse_number_field(first, last).has_value()
+constexpr bool validate_number(const char* const first, const char* const last) noexcept {
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && is_short_field(first, last - first)) {
+        return validate_number_with(classify_short_field(first, static_cast<int>(last - first)));
+    }
+#endif
+    return validate_number_with(ScalarClassCursor{first, static_cast<int>(last - first)});
+}
+
+// Mismo resultado que parse_digit_format_field(first, last).has_value()
+constexpr bool validate_digit_format(const char* const first, const char* const last) noexcept {
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && is_short_field(first, last - first)) {
+        return validate_digit_format_with(classify_short_field(first, static_cast<int>(last - first)));
+    }
+#endif
+    return validate_digit_format_with(ScalarClassCursor{first, static_cast<int>(last - first)});
+}
+
+// Longitud de una cadena terminada en '\0'; en ejecución, los 32 primeros bytes se miran
+// de una vez si no cruzan de página
+constexpr int validate_field_length(const char* const str) noexcept {
+#if XPERIMENT_RUNTIME_SIMD
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED() && (reinterpret_cast<std::uintptr_t>(str) & 4095u) <= 4096u - 32) {
+        const std::uint32_t nul = nul_mask32(str);
+        if (nul != 0) {
+            return lowest_set_bit(nul);
+        }
+    }
+#endif
+    int length = 0;
+    while (str[length] != '\0') {
+        length++;
+    }
+    return length;
+}
+
+// Versiones terminadas en '\0': validate_digit_format(str) da el mismo resultado que
+// parse_digit_format_simple(str).has_value()
+constexpr bool validate_number(const char* const str) noexcept {
+    return validate_number(str, str + validate_field_length(str));
+}
+
+constexpr bool validate_digit_format(const char* const str) noexcept {
+    return validate_digit_format(str, str + validate_field_length(str));
+}
+
+#endif // PARSE_VALIDATE_HPP
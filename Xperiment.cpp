@@ -1,9 +1,19 @@
 #include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <type_traits>
 #include <limits>
 #include "expected_cpp14.hpp"
 #include "ParseError.hpp"
+#include "ParseFloat.hpp"
+#include "ParseInteger.hpp"
+#include "ParseRadix.hpp"
+#include "ParseSeparator.hpp"
+#include "ParseSimd.hpp"
+#include "ParseStream.hpp"
+#include "ParseValidate.hpp"
+#include "divider.hpp"
+#include "digits.hpp"
 
 struct Xperiment {
     const Expected<std::uint64_t, ParseError> result;
@@ -65,6 +75,114 @@ static_assert(!experimentError3.result && experimentError3.result.error() == Par
 static_assert(!experimentError4.result && experimentError4.result.error() == ParseError::BlankInterDigits, "Blank inter digits should fail");
 static_assert(experimentError5.result && *experimentError5.result == 123, "Leading/trailing whitespace should succeed");
 
+// Tests para las versiones acotadas [first, last): sin '\0', se detienen en `last`
+constexpr const char boundedInput[] = "1234567890123|d#5#B3 tail";
+constexpr const char* bounded_end_of(const char* first, const char* last) {
+    const char* end = first;
+    return parse_number_simple(first, last, end) ? end : nullptr;
+}
+static_assert(bounded_end_of(boundedInput, boundedInput + 13) == boundedInput + 13, "Bounded parse should stop at '|'");
+static_assert(bounded_end_of(boundedInput, boundedInput + 4) == boundedInput + 4, "Bounded parse should stop at last");
+
+constexpr const char* bounded_digit_end_of(const char* first, const char* last) {
+    const char* end = first;
+    return parse_digit_format_simple(first, last, end) ? end : nullptr;
+}
+static_assert(bounded_digit_end_of(boundedInput + 14, boundedInput + 25) == boundedInput + 20, "Bounded d#5#B3 should stop before ' tail'");
+
+// Tests para parse_integer<T>: límites y signo por tipo
+constexpr const char int32MinInput[] = "-2147483648";
+constexpr const char int32OverflowInput[] = "2147483648";
+constexpr const char portInput[] = "65535";
+constexpr const char portOverflowInput[] = "65536";
+constexpr const char negativePortInput[] = "-1";
+static_assert(*parse_integer_field<std::int32_t>(int32MinInput, int32MinInput + 11) == -2147483647 - 1, "int32 min should parse");
+static_assert(parse_integer_field<std::int32_t>(int32OverflowInput, int32OverflowInput + 10).error() == ParseError::Overflow, "int32 max + 1 should overflow");
+static_assert(*parse_integer_field<std::uint16_t>(portInput, portInput + 5) == 65535, "uint16 max should parse");
+static_assert(parse_integer_field<std::uint16_t>(portOverflowInput, portOverflowInput + 5).error() == ParseError::Overflow, "uint16 max + 1 should overflow");
+static_assert(parse_integer_field<std::uint16_t>(negativePortInput, negativePortInput + 2).error() == ParseError::InvalidCharacter, "Unsigned types should reject '-'");
+
+// Tests para parse_number<Radix>
+constexpr const char hexMaxInput[] = "FFFFffffFFFFffff";
+constexpr const char hexOverflowInput[] = "10000000000000000";
+constexpr const char binaryInput[] = "101010";
+constexpr const char octalOverflowInput[] = "2000000000000000000000";
+static_assert(*parse_number_field<16>(hexMaxInput, hexMaxInput + 16) == 18446744073709551615ULL, "16 hex digits should parse to max uint64_t");
+static_assert(parse_number_field<16>(hexOverflowInput, hexOverflowInput + 17).error() == ParseError::Overflow, "17 hex digits should overflow");
+static_assert(*parse_number_field<2>(binaryInput, binaryInput + 6) == 42, "Binary 101010 should be 42");
+static_assert(parse_number_field<8>(octalOverflowInput, octalOverflowInput + 22).error() == ParseError::Overflow, "Octal 2 * 8^21 should overflow");
+static_assert(parse_number_field<2>(binaryInput, binaryInput + 6) && !parse_number_field<2>(hexMaxInput, hexMaxInput + 16), "Hex digits are not binary");
+
+// Tests para skip_whitespace: rachas de más de 32 blancos (en ejecución van por SIMD)
+constexpr const char paddedInput[] = "  \t                                  \r\n          42";
+constexpr const char paddedDigitInput[] = "d#                                    5   #                                  B3";
+static_assert(skip_whitespace(paddedInput, 0) == 49 && skip_whitespace(paddedInput, paddedInput + 51) == paddedInput + 49, "Padding should be skipped up to '42'");
+static_assert(*parse_number_field(paddedInput, paddedInput + 51) == 42, "Padded field should parse");
+static_assert(parse_digit_format_simple(paddedDigitInput) && parse_digit_format_simple(paddedDigitInput)->digit == 5 &&
+              parse_digit_format_simple(paddedDigitInput)->base == 3, "Padded d#5#B3 should parse");
+
+// Tests para ParseFailure: código y byte donde se detuvo el análisis
+constexpr const char blankInterDigitsInput[] = "  12 34 ";
+constexpr const char overflowFieldInput[] = " 184467440737095516159";
+static_assert(parse_number_field_located(blankInterDigitsInput, blankInterDigitsInput + 8).error() == ParseFailure(ParseError::BlankInterDigits, 5), "'  12 34 ' should fail at the '3'");
+static_assert(parse_number_field_located(overflowFieldInput, overflowFieldInput + 22).error() == ParseFailure(ParseError::Overflow, 21), "Overflow should point at the 21st digit");
+static_assert(parse_digit_format_located("d#5#C3").error() == ParseFailure(ParseError::MissingB, 4), "d#5#C3 should fail at the 'C'");
+static_assert(parse_digit_format_located("d#5#B3 x").error() == ParseFailure(ParseError::InvalidCharacter, 7), "d#5#B3 x should fail at the 'x'");
+
+// Tests para validate_number / validate_digit_format: mismas reglas que los parsers
+static_assert(validate_number(paddedInput) && !validate_number(blankInterDigitsInput) && !validate_number(overflowFieldInput), "validate_number should match parse_number_field");
+static_assert(validate_digit_format("d#5#B3") && validate_digit_format("dig [7] B 10  ") && validate_digit_format("d#5#B4294967296"), "Well-formed digit literals should validate");
+static_assert(!validate_digit_format("d#5]B3") && !validate_digit_format("d#5#B0") && !validate_digit_format("d#5#B4294967297"), "validate_digit_format should match parse_digit_format_simple");
+
+// Tests para parse_number_separated: separadores solo entre dígitos
+constexpr const char groupedInput[] = "18_446_744_073_709_551_615";
+constexpr const char quotedInput[] = "1'000'000";
+constexpr const char doubledSeparatorInput[] = "1__000";
+constexpr const char trailingSeparatorInput[] = " 1_000_ ";
+static_assert(*parse_number_separated_field<'_'>(groupedInput, groupedInput + 26) == 18446744073709551615ULL, "Grouped max uint64_t should parse");
+static_assert(*parse_number_separated_field<'\''>(quotedInput, quotedInput + 9) == 1000000, "1'000'000 should parse");
+static_assert(parse_number_separated_field_located<'_'>(doubledSeparatorInput, doubledSeparatorInput + 6).error() == ParseFailure(ParseError::MisplacedSeparator, 1), "1__000 should fail at the first '_'");
+static_assert(parse_number_separated_field<'_'>(trailingSeparatorInput, trailingSeparatorInput + 8).error() == ParseError::MisplacedSeparator, "1_000_ should fail");
+static_assert(!parse_number_field(groupedInput, groupedInput + 26), "parse_number_field should still reject separators");
+
+// Tests para FastDivider: los tres tipos de mágico (64 bits, 65 bits, potencia de dos)
+static_assert(FastDivider(10).remainder(18446744073709551615ULL) == 5 && FastDivider(10).divide(18446744073709551615ULL) == 1844674407370955161ULL, "Division by 10 should be exact");
+static_assert(FastDivider(7).remainder(18446744073709551615ULL) == 18446744073709551615ULL % 7 && FastDivider(7).add, "Divisor 7 needs the 65-bit magic");
+static_assert(FastDivider(4294967296ULL).remainder(18446744073709551615ULL) == 4294967295ULL && FastDivider(1).remainder(12345) == 0, "Powers of two should shift");
+static_assert(FastDivider(4294967295ULL).divide(18446744073709551615ULL) == 4294967297ULL, "Largest non power of two base should divide exactly");
+
+// Tests para literales de dígito: la base del texto fija el tipo y el módulo se hace al compilar
+static_assert(XPERIMENT_DIGIT("d#5#B3").value == 2, "d#5#B3 should reduce to 2");
+static_assert(std::is_same<decltype(XPERIMENT_DIGIT("d#5#B3")), const digit<3>>::value, "d#5#B3 should be a const digit<3>");
+static_assert(XPERIMENT_DIGIT("dig[255]B256").value == 255 && XPERIMENT_DIGIT("d#100#B7").value == 2, "Literal digits should reduce at compile time");
+
+// Tests para digit<B>: resta con vuelta, productos cerca de 2^32, máscara de B = 2^32, pow e inverse
+static_assert((digit<7>(2) - digit<7>(5)).value == 4 && (digit<256>(1) - digit<256>(2)).value == 255, "Subtraction should wrap around");
+static_assert((digit<4294967291ULL>(0) - digit<4294967291ULL>(1)).value == 4294967290u, "Subtraction should wrap around near 2^32");
+static_assert((digit<4294967291ULL>(4294967290ULL) * digit<4294967291ULL>(4294967290ULL)).value == 1 &&
+              (digit<4294967291ULL>(3000000000ULL) * digit<4294967291ULL>(3000000000ULL)).value == 1392778655u, "Products mod 2^32 - 5 should reduce");
+static_assert((digit<4294967295ULL>(4294967294ULL) * digit<4294967295ULL>(4294967294ULL)).value == 1 &&
+              digit<4294967291ULL>(18446744073709551615ULL).value == 24, "Products mod 2^32 - 1 should reduce");
+static_assert((digit<4294967296ULL>(4294967295ULL) + digit<4294967296ULL>(2)).value == 1 &&
+              (digit<4294967296ULL>(0) - digit<4294967296ULL>(1)).value == 4294967295u &&
+              (digit<4294967296ULL>(4294967295ULL) * digit<4294967296ULL>(4294967295ULL)).value == 1, "B = 2^32 should use the mask");
+static_assert(digit<1000000007>(2).pow(1000000006).value == 1 && digit<1000000007>(3).pow(200).value == 136318165u &&
+              digit<10>(3).pow(4).value == 1 && digit<1000>(2).pow(10).value == 24 && digit<7>(5).pow(0).value == 1, "pow should match known values");
+static_assert(digit<4294967291ULL>(123456789) * digit<4294967291ULL>(123456789).inverse() == digit<4294967291ULL>(1) &&
+              digit<4294967291ULL>(123456789).inverse().value == 2196879611u && digit<4294967291ULL>(0).inverse().value == 0, "inverse near 2^32 should invert");
+
+// Tests para HotBaseDispatcher: solo las bases de la lista tienen núcleo propio
+static_assert(HotBaseDispatcher::is_hot(10) && HotBaseDispatcher::is_hot(1000000000) && HotBaseDispatcher::is_hot(256), "Listed bases should be hot");
+static_assert(!HotBaseDispatcher::is_hot(11) && !HotBaseDispatcher::is_hot(0) && !HotBaseDispatcher::is_hot(4294967296ULL), "Other bases should take the generic path");
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+namespace digit_literal_tests {
+using namespace digit_literals;
+static_assert("dig[15]B16"_digit.value == 15, "dig[15]B16 should keep 15");
+static_assert(std::is_same<decltype("dig[15]B16"_digit), digit<16>>::value, "dig[15]B16 should be a digit<16>");
+} // namespace digit_literal_tests
+#endif
+
 // Mantener la función original para runtime
 constexpr Expected<DigitResult, ParseError> parse_digit_format(const char* const str) noexcept {
     return parse_digit_format_simple(str);
@@ -79,11 +197,18 @@ const char* parseErrorToString(ParseError e) noexcept {
     case ParseError::Empty: return "Empty";
     case ParseError::InvalidPrefix: return "InvalidPrefix";
     case ParseError::MissingDelimiter: return "MissingDelimiter";
+    case ParseError::EmptyDigit: return "EmptyDigit";
     case ParseError::MismatchedDelimiter: return "MismatchedDelimiter";
     case ParseError::InvalidDigit: return "InvalidDigit";
     case ParseError::MissingB: return "MissingB";
     case ParseError::InvalidBase: return "InvalidBase";
+    case ParseError::EmptyBase: return "EmptyBase";
+    case ParseError::BlankInterDigitsOfBase: return "BlankInterDigitsOfBase";
     case ParseError::BaseOutOfRange: return "BaseOutOfRange";
+    case ParseError::InvalidMantissa: return "InvalidMantissa";
+    case ParseError::InvalidExponent: return "InvalidExponent";
+    case ParseError::MisplacedSeparator: return "MisplacedSeparator";
+    case ParseError::UnknownError: return "UnknownError";
     }
     return "Unknown";
 }
@@ -128,5 +253,61 @@ int main() {
         std::cout << "d #42# B 8: failed with " << parseErrorToString(rt3.error()) << "\n";
     }
 
+    // Núcleo SIMD elegido por cpuid (mismo resultado que parse_number_simple)
+    std::cout << "\n=== Runtime SIMD Parse Tests ===\n";
+    std::cout << "simd level: " << static_cast<int>(simd_level()) << "\n";
+    int simd_end = 0;
+    auto simd1 = parse_number_fast("12345678901234567890 ", 0, simd_end);
+    std::cout << "12345678901234567890: success=" << simd1.has_value() << " value=" << (simd1.has_value() ? simd1.value() : 0)
+              << " end=" << simd_end << "\n";
+
+    std::cout << "\n=== Runtime Double Parse Tests ===\n";
+    const char* const doubleInputs[] = {"3.14159", " -2.5e-3 ", "1e308", "1e309", "1.5e", "-.", "6.02214076e23"};
+    for (const char* input : doubleInputs) {
+        const Expected<double, ParseError> d = parse_double_field(input, input + std::strlen(input));
+        if (d.has_value()) {
+            std::cout << "\"" << input << "\": value=" << d.value() << "\n";
+        } else {
+            std::cout << "\"" << input << "\": failed with " << parseErrorToString(d.error()) << "\n";
+        }
+    }
+
+    // Rachas cortas y largas, bases calientes, genéricas y base 0, contra el % de referencia
+    std::cout << "\n=== Runtime Base Dispatch Tests ===\n";
+    HotBaseDispatcher dispatcher;
+    std::uint64_t dispatch_digits[40];
+    std::uint64_t dispatch_bases[40];
+    std::uint64_t dispatch_out[40];
+    const std::uint64_t dispatch_pool[] = {10, 11, 1000000000, 4294967295ULL, 0, 256, 7, 12345};
+    for (std::size_t i = 0; i < 40; ++i) {
+        dispatch_digits[i] = 18446744073709551615ULL - i * 1000003;
+        dispatch_bases[i] = i < 16 ? dispatch_pool[i % 8] : dispatch_pool[(i / 12) % 8];
+    }
+    dispatcher.reduce(dispatch_digits, dispatch_bases, dispatch_out, 40);
+    std::size_t dispatch_mismatches = 0;
+    for (std::size_t i = 0; i < 40; ++i) {
+        const std::uint64_t expected = dispatch_bases[i] == 0 ? 0 : dispatch_digits[i] % dispatch_bases[i];
+        dispatch_mismatches += dispatch_out[i] != expected || dispatcher.reduce(dispatch_digits[i], dispatch_bases[i]) != expected;
+    }
+    std::cout << "40 values: mismatches=" << dispatch_mismatches << " first=" << dispatch_out[0] << " last=" << dispatch_out[39] << "\n";
+
+    // Literal partido entre dos buffers: el parser incremental conserva el estado
+    std::cout << "\n=== Streaming Digit Format Tests ===\n";
+    DigitStreamParser stream;
+    auto print_stream = [](std::uint64_t line, const Expected<DigitResult, ParseError>& r) {
+        if (r.has_value()) {
+            std::cout << "line " << line << ": digit=" << r.value().digit << " base=" << r.value().base << " result=" << r.value().result << "\n";
+        } else {
+            std::cout << "line " << line << ": failed with " << parseErrorToString(r.error()) << "\n";
+        }
+    };
+    const char chunk1[] = "d#12";
+    const char chunk2[] = "3#B25\ndig[7]B";
+    const char chunk3[] = "4";
+    stream.feed(chunk1, chunk1 + sizeof(chunk1) - 1, print_stream);
+    stream.feed(chunk2, chunk2 + sizeof(chunk2) - 1, print_stream);
+    stream.feed(chunk3, chunk3 + sizeof(chunk3) - 1, print_stream);
+    stream.finish(print_stream);
+
     return 0;
 }
\ No newline at end of file
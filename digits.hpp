@@ -1,25 +1,151 @@
+#ifndef DIGITS_HPP
+#define DIGITS_HPP
+
 #include <cstdint>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
 #include <stdexcept>
 #include <new> // For placement new
 #include <limits>
 
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+#include "divider.hpp"
+
+// Estrategia de reducción módulo B, elegida en compilación por B (ninguna divide):
+struct PowerOfTwoModulus {};  // B = 2^k: máscara
+struct ReciprocalModulus {};  // Resto: FastDivider de compilación (mulhi, desplazamientos y mul)
+
+template<std::uint64_t B>
+using ModulusStrategy = typename std::conditional<(B & (B - 1)) == 0, PowerOfTwoModulus, ReciprocalModulus>::type;
+
+template<std::uint64_t B>
+constexpr std::uint32_t reduce_modulo(std::uint64_t v, PowerOfTwoModulus) noexcept {
+    return static_cast<std::uint32_t>(v & (B - 1));
+}
+
+template<std::uint64_t B>
+constexpr std::uint32_t reduce_modulo(std::uint64_t v, ReciprocalModulus) noexcept {
+    return static_cast<std::uint32_t>(DividerFor<B>::value.remainder(v));
+}
+
+// v % B con la estrategia de B
+template<std::uint64_t B>
+constexpr std::uint32_t reduce_modulo(std::uint64_t v) noexcept {
+    return reduce_modulo<B>(v, ModulusStrategy<B>{});
+}
+
+// Primalidad por división de prueba; solo se evalúa en compilación (static_assert de inverse)
+constexpr bool is_prime_base(std::uint64_t b) noexcept {
+    if (b < 4) {
+        return b >= 2;
+    }
+    if (b % 2 == 0) {
+        return false;
+    }
+    for (std::uint64_t d = 3; d * d <= b; d += 2) {
+        if (b % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Las restricciones de B van en static_assert en lugar de requires para que digit<B>
+// se pueda usar también desde C++14. value es el residuo en [0, B); las operaciones
+// (+, -, *, pow, inverse) son constexpr y no usan división: con B <= 2^32 los residuos
+// caben en 32 bits, la suma en 33 y el producto en 64, que reduce_modulo lleva a [0, B).
 template<std::uint64_t B>
-	requires (B >= 2 && B-1 <= std::numeric_limits<std::uint32_t>::max())
 struct digit {
+    static_assert(B >= 2 && B - 1 <= std::numeric_limits<std::uint32_t>::max(), "digit<B> requiere 2 <= B <= 2^32");
     std::uint32_t value;
-    constexpr digit(std::uint64_t v) noexcept : value(static_cast<std::uint32_t>(v % B)) {}
+    constexpr digit(std::uint64_t v) noexcept : value(reduce_modulo<B>(v)) {}
+
+    // Residuo ya reducido (< B), sin volver a reducir
+    static constexpr digit from_residue(std::uint32_t residue) noexcept {
+        digit result(0);
+        result.value = residue;
+        return result;
+    }
+
+    // this^exponent por cuadrados sucesivos
+    constexpr digit pow(std::uint64_t exponent) const noexcept {
+        digit result(1);
+        digit square = *this;
+        while (exponent != 0) {
+            if ((exponent & 1u) != 0) {
+                result = result * square;
+            }
+            square = square * square;
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    // Inverso multiplicativo por Fermat (this^(B - 2)); el 0 no tiene y devuelve 0
+    constexpr digit inverse() const noexcept {
+        static_assert(is_prime_base(B), "inverse() requiere B primo");
+        return value == 0 ? *this : pow(B - 2);
+    }
 };
 
+// Suma y resta: los residuos son < B, basta una resta condicional (o la máscara)
+template<std::uint64_t B>
+constexpr digit<B> add_residues(digit<B> a, digit<B> b, PowerOfTwoModulus) noexcept {
+    return digit<B>::from_residue(static_cast<std::uint32_t>((std::uint64_t(a.value) + b.value) & (B - 1)));
+}
+
+template<std::uint64_t B>
+constexpr digit<B> add_residues(digit<B> a, digit<B> b, ReciprocalModulus) noexcept {
+    const std::uint64_t sum = std::uint64_t(a.value) + b.value;
+    return digit<B>::from_residue(static_cast<std::uint32_t>(sum >= B ? sum - B : sum));
+}
+
+template<std::uint64_t B>
+constexpr digit<B> subtract_residues(digit<B> a, digit<B> b, PowerOfTwoModulus) noexcept {
+    return digit<B>::from_residue(static_cast<std::uint32_t>((std::uint64_t(a.value) - b.value) & (B - 1)));
+}
+
+template<std::uint64_t B>
+constexpr digit<B> subtract_residues(digit<B> a, digit<B> b, ReciprocalModulus) noexcept {
+    return digit<B>::from_residue(static_cast<std::uint32_t>(a.value >= b.value ? std::uint64_t(a.value) - b.value
+                                                                                : std::uint64_t(a.value) + B - b.value));
+}
+
+template<std::uint64_t B>
+constexpr digit<B> operator+(digit<B> a, digit<B> b) noexcept {
+    return add_residues(a, b, ModulusStrategy<B>{});
+}
+
+template<std::uint64_t B>
+constexpr digit<B> operator-(digit<B> a, digit<B> b) noexcept {
+    return subtract_residues(a, b, ModulusStrategy<B>{});
+}
+
+template<std::uint64_t B>
+constexpr digit<B> operator*(digit<B> a, digit<B> b) noexcept {
+    return digit<B>::from_residue(reduce_modulo<B>(std::uint64_t(a.value) * b.value));
+}
+
+template<std::uint64_t B>
+constexpr bool operator==(digit<B> a, digit<B> b) noexcept {
+    return a.value == b.value;
+}
+
+template<std::uint64_t B>
+constexpr bool operator!=(digit<B> a, digit<B> b) noexcept {
+    return a.value != b.value;
+}
+
 template<std::uint64_t B>
-	requires (B >= 2 && B - 1 <= std::numeric_limits<std::uint32_t>::max())
 struct DigitXperiment {
-    const Expected<digit<B>, ParseError> result;
+    static_assert(B >= 2 && B - 1 <= std::numeric_limits<std::uint32_t>::max(), "DigitXperiment<B> requiere 2 <= B <= 2^32");
+    const Expected<::digit<B>, ParseError> result;
 
     constexpr DigitXperiment(const char* const experimentName) noexcept
         : result(parse_digit_format_simple(experimentName)) {}
-    
+
     // Convenience accessors
     constexpr std::uint32_t digit() const noexcept { return result.value().digit; }
     constexpr std::uint32_t base() const noexcept { return result.value().base; }
@@ -27,3 +153,220 @@ struct DigitXperiment {
     constexpr ParseError error() const noexcept { return result.error(); }
     constexpr bool success() const noexcept { return result.has_value(); }
 };
+
+// Literales de dígito resueltos en compilación: la base del texto pasa a ser el
+// parámetro de digit<B> y el módulo se hace al compilar. Un literal mal formado da
+// base 0 y falla el static_assert de DigitLiteral.
+constexpr std::uint64_t digit_literal_base(const char* const str) noexcept {
+    return parse_digit_format_simple(str) ? parse_digit_format_simple(str)->base : 0;
+}
+
+constexpr std::uint64_t digit_literal_digit(const char* const str) noexcept {
+    return parse_digit_format_simple(str) ? parse_digit_format_simple(str)->digit : 0;
+}
+
+template<std::uint64_t B, std::uint64_t Digit>
+struct DigitLiteral {
+    static_assert(B >= 2, "Literal de dígito inválido o con base menor que 2");
+    static constexpr ::digit<B> value{Digit};
+};
+
+template<std::uint64_t B, std::uint64_t Digit>
+constexpr ::digit<B> DigitLiteral<B, Digit>::value;
+
+// C++14: XPERIMENT_DIGIT("d#5#B3") es un digit<3> constante con value 2. Sin paréntesis
+// exteriores, decltype da el tipo declarado (const digit<3>) y no una referencia.
+#define XPERIMENT_DIGIT(literal) \
+    DigitLiteral<digit_literal_base(literal), digit_literal_digit(literal)>::value
+
+// --- Despacho de bases de ejecución a digit<B> ---
+//
+// parse_digit_format_simple da la base en ejecución. BaseDispatcher<Bases...> lleva cada
+// base de la lista a núcleos instanciados con digit<B>, donde el módulo es una constante
+// (máscara en potencias de dos, multiplicación por el mágico de compilación en el resto),
+// mediante una tabla de punteros a función indexada por un hash sin colisiones calculado
+// en compilación. Las demás bases van al camino genérico: divisor de la DividerCache.
+
+using FixedRunKernel = void (*)(const std::uint64_t*, std::uint64_t*, std::size_t);
+using FixedValueKernel = std::uint64_t (*)(std::uint64_t);
+
+template<std::uint64_t B>
+void reduce_fixed_run(const std::uint64_t* const digits, std::uint64_t* const out, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = ::digit<B>(digits[i]).value;
+    }
+}
+
+template<std::uint64_t B>
+std::uint64_t reduce_fixed(std::uint64_t v) noexcept {
+    return ::digit<B>(v).value;
+}
+
+struct DispatchSlot {
+    std::uint64_t base;  // 0: libre
+    FixedRunKernel run;
+    FixedValueKernel value;
+};
+
+// Tabla de Size huecos (potencia de dos): hueco de b = (b * multiplier) >> shift.
+// multiplier 0 indica que no se encontró ninguno sin colisiones.
+template<std::size_t Size>
+struct DispatchTable {
+    DispatchSlot slots[Size];
+    std::uint64_t multiplier;
+    unsigned shift;
+};
+
+constexpr std::size_t dispatch_table_size(std::size_t bases) noexcept {
+    std::size_t size = 8;
+    while (size < 4 * bases) {
+        size *= 2;
+    }
+    return size;
+}
+
+template<std::size_t Size>
+constexpr unsigned dispatch_shift() noexcept {
+    unsigned log = 0;
+    while ((std::size_t(1) << log) < Size) {
+        log++;
+    }
+    return 64 - log;
+}
+
+// Prueba multiplicadores impares a partir del de Fibonacci hasta que las bases caen en
+// huecos distintos
+template<std::size_t Size, std::uint64_t... Bases>
+constexpr DispatchTable<Size> make_dispatch_table() noexcept {
+    const std::uint64_t bases[] = {Bases...};
+    const FixedRunKernel runs[] = {&reduce_fixed_run<Bases>...};
+    const FixedValueKernel values[] = {&reduce_fixed<Bases>...};
+    const unsigned shift = dispatch_shift<Size>();
+    for (std::uint64_t attempt = 0; attempt < 4096; ++attempt) {
+        DispatchTable<Size> table{};
+        table.multiplier = 0x9E3779B97F4A7C15ULL + 2 * attempt;
+        table.shift = shift;
+        bool collision = false;
+        for (std::size_t i = 0; i < sizeof...(Bases) && !collision; ++i) {
+            DispatchSlot& slot = table.slots[(bases[i] * table.multiplier) >> shift];
+            collision = slot.base != 0;
+            slot = DispatchSlot{bases[i], runs[i], values[i]};
+        }
+        if (!collision) {
+            return table;
+        }
+    }
+    return DispatchTable<Size>{};
+}
+
+// Racha mínima para despachar: con bases mezcladas, la llamada indirecta (de racha o de
+// valor) se predice mal y cuesta más que reducir unos pocos valores con el divisor de la
+// caché, que tampoco divide
+constexpr std::size_t dispatch_min_run = 8;
+
+template<std::uint64_t... Bases>
+class BaseDispatcher {
+public:
+    // ¿Tiene `base` núcleo propio?
+    static constexpr bool is_hot(std::uint64_t base) noexcept {
+        return base != 0 && slot_of(base).base == base;
+    }
+
+    // digit % base (0 con base 0)
+    std::uint64_t reduce(std::uint64_t digit, std::uint64_t base) {
+        const DispatchSlot& slot = slot_of(base);
+        if (slot.base == base && base != 0) {
+            return slot.value(digit);
+        }
+        return base == 0 ? 0 : cache_.divider(cache_.index_of(base)).remainder(digit);
+    }
+
+    // Como reduce_digits: un despacho por racha larga de la misma base; las
+    // rachas cortas, de cualquier base, con el divisor de la caché
+    void reduce(const std::uint64_t* const digits, const std::uint64_t* const bases, std::uint64_t* const out,
+                std::size_t count) {
+        std::size_t i = 0;
+        while (i < count) {
+            const std::uint64_t base = bases[i];
+            std::size_t run_end = i + 1;
+            while (run_end < count && bases[run_end] == base) {
+                run_end++;
+            }
+            if (base == 0) {
+                for (std::size_t j = i; j < run_end; ++j) {
+                    out[j] = 0;
+                }
+            } else if (run_end - i < dispatch_min_run) {
+                const FastDivider& divider = cache_.divider(cache_.index_of(base));
+                for (std::size_t j = i; j < run_end; ++j) {
+                    out[j] = divider.remainder(digits[j]);
+                }
+            } else if (slot_of(base).base == base) {
+                slot_of(base).run(digits + i, out + i, run_end - i);
+            } else {
+                generic_(cache_.divider(cache_.index_of(base)), digits + i, out + i, run_end - i);
+            }
+            i = run_end;
+        }
+    }
+
+private:
+    static constexpr std::size_t table_size = dispatch_table_size(sizeof...(Bases));
+    static constexpr DispatchTable<table_size> table = make_dispatch_table<table_size, Bases...>();
+    static_assert(sizeof...(Bases) > 0, "BaseDispatcher necesita al menos una base");
+    static_assert(table.multiplier != 0, "Bases repetidas o sin hash sin colisiones");
+
+    static constexpr const DispatchSlot& slot_of(std::uint64_t base) noexcept {
+        return table.slots[(base * table.multiplier) >> table.shift];
+    }
+
+    DividerCache cache_;
+    ReduceRunKernel generic_ = select_reduce_run_kernel(simd_level());
+};
+
+template<std::uint64_t... Bases>
+constexpr DispatchTable<BaseDispatcher<Bases...>::table_size> BaseDispatcher<Bases...>::table;
+
+// Bases habituales en nuestros flujos
+using HotBaseDispatcher = BaseDispatcher<2, 3, 7, 8, 10, 16, 256, 1000000000>;
+
+// C++20: "d#5#B3"_digit, con el texto como parámetro de plantilla
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+
+template<std::size_t N>
+struct DigitLiteralString {
+    char chars[N];
+
+    constexpr DigitLiteralString(const char (&str)[N]) noexcept : chars{} {
+        for (std::size_t i = 0; i < N; ++i) {
+            chars[i] = str[i];
+        }
+    }
+};
+
+// Se analiza una copia local: GCC con -fsanitize=undefined no acepta comparar con nullptr
+// la dirección del objeto parámetro de plantilla en una expresión constante
+template<DigitLiteralString Literal>
+constexpr std::uint64_t digit_literal_string_base() noexcept {
+    const DigitLiteralString copy = Literal;
+    return digit_literal_base(copy.chars);
+}
+
+template<DigitLiteralString Literal>
+constexpr std::uint64_t digit_literal_string_digit() noexcept {
+    const DigitLiteralString copy = Literal;
+    return digit_literal_digit(copy.chars);
+}
+
+namespace digit_literals {
+
+template<DigitLiteralString Literal>
+constexpr ::digit<digit_literal_string_base<Literal>()> operator""_digit() noexcept {
+    return DigitLiteral<digit_literal_string_base<Literal>(), digit_literal_string_digit<Literal>()>::value;
+}
+
+} // namespace digit_literals
+
+#endif
+
+#endif // DIGITS_HPP
@@ -0,0 +1,434 @@
+#ifndef DIVIDER_HPP
+#define DIVIDER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ParseError.hpp"
+#include "ParseInteger.hpp"
+#include "ParseSimd.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// División y módulo de un uint64_t por un divisor fijo d (1 <= d <= 2^32) con una
+// multiplicación alta, desplazamientos y una multiplicación baja, sin instrucción de
+// división. Los números mágicos son los de Granlund-Montgomery (como en libdivide):
+//   - si el mágico redondeado hacia arriba cabe en 64 bits: q = mulhi(m, n) >> s;
+//   - si no (necesitaría 65 bits), con su bit alto implícito:
+//     t = mulhi(m, n), q = (t + ((n - t) >> 1)) >> s;
+//   - potencias de dos (incluido 1): m = 0 y q = n >> s por la misma fórmula.
+// Construirlo cuesta dos divisiones; se hace una vez por base, en compilación para
+// digit<B> o en ejecución para las bases leídas (DigitResult::base).
+
+// Mitad alta del producto de 64 x 64 bits
+constexpr std::uint64_t multiply_high64(std::uint64_t a, std::uint64_t b) noexcept {
+#if XPERIMENT_HAS_INT128
+    return static_cast<std::uint64_t>((static_cast<uint128>(a) * b) >> 64);
+#else
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+    if (!XPERIMENT_IS_CONSTANT_EVALUATED()) {
+        return __umulh(a, b);
+    }
+#endif
+    // Cuatro productos de 32 x 32 bits
+    const std::uint64_t a_low = a & 0xFFFFFFFFu, a_high = a >> 32;
+    const std::uint64_t b_low = b & 0xFFFFFFFFu, b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low;
+    const std::uint64_t high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high;
+    const std::uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + low_high;
+    return a_high * b_high + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+// d >= 1
+constexpr unsigned divider_floor_log2(std::uint64_t d) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(d));
+#else
+    unsigned log = 0;
+    while (d > 1) {
+        d >>= 1;
+        log++;
+    }
+    return log;
+#endif
+}
+
+// floor(2^(64 + k) / d) y su resto, con 2^k <= d <= 2^32: división larga en dos pasos
+// de 32 bits, cada uno con dividendo < 2^64 (con 2^k = d el cociente no cabe y no se usa)
+struct DividerQuotient {
+    std::uint64_t quotient;
+    std::uint64_t remainder;
+};
+
+constexpr DividerQuotient divide_power_of_two(unsigned k, std::uint64_t d) noexcept {
+    const std::uint64_t high = (std::uint64_t(1) << k) << 32;
+    const std::uint64_t low = (high % d) << 32;
+    return DividerQuotient{((high / d) << 32) | (low / d), low % d};
+}
+
+struct FastDivider {
+    std::uint64_t divisor;
+    std::uint64_t magic;
+    unsigned shift;
+    bool add;  // Mágico de 65 bits: paso de corrección (t + ((n - t) >> add_shift))
+    unsigned add_shift;
+
+    constexpr explicit FastDivider(std::uint64_t d) noexcept
+        : FastDivider(d, divider_floor_log2(d), divide_power_of_two(divider_floor_log2(d), d)) {}
+
+    // Sin salto en `add`: con divisores distintos valor a valor, el salto se predice mal
+    constexpr std::uint64_t divide(std::uint64_t n) const noexcept {
+        const std::uint64_t t = multiply_high64(magic, n);
+        return (t + (((n - t) >> add_shift) & (std::uint64_t(0) - static_cast<std::uint64_t>(add)))) >> shift;
+    }
+
+    constexpr std::uint64_t remainder(std::uint64_t n) const noexcept {
+        return n - divide(n) * divisor;
+    }
+
+private:
+    // quotient = floor(2^(64 + k) / d) con k = floor(log2(d)). El mágico redondeado hacia
+    // arriba, quotient + 1, vale con el desplazamiento k si su error d - resto es menor
+    // que 2^k; si no, el de 65 bits es floor(2^(65 + k) / d) + 1 sin su bit alto.
+    constexpr FastDivider(std::uint64_t d, unsigned k, DividerQuotient q) noexcept
+        : divisor(d),
+          magic((d & (d - 1)) == 0 ? 0
+                : d - q.remainder < (std::uint64_t(1) << k) ? q.quotient + 1
+                : 2 * q.quotient + (2 * q.remainder >= d ? 1 : 0) + 1),
+          shift(k),
+          add((d & (d - 1)) == 0 || d - q.remainder >= (std::uint64_t(1) << k)),
+          add_shift((d & (d - 1)) == 0 ? 0 : 1) {}
+};
+
+// Divisor de compilación por base: una sola copia en todo el programa (miembro estático
+// de plantilla, C++14 no tiene variables inline)
+template<std::uint64_t B>
+struct DividerFor {
+    static constexpr FastDivider value{B};
+};
+
+template<std::uint64_t B>
+constexpr FastDivider DividerFor<B>::value;
+
+// remainder para una racha de n valores con el mismo divisor: la elección de fórmula sale
+// del bucle y cada valor queda en mulhi, desplazamientos, mul y resta
+inline void reduce_run(const FastDivider& divider, const std::uint64_t* const digits, std::uint64_t* const out,
+                       std::size_t n) noexcept {
+    const std::uint64_t magic = divider.magic;
+    const std::uint64_t d = divider.divisor;
+    const unsigned shift = divider.shift;
+    if (divider.add) {
+        const unsigned add_shift = divider.add_shift;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint64_t t = multiply_high64(magic, digits[i]);
+            out[i] = digits[i] - ((t + ((digits[i] - t) >> add_shift)) >> shift) * d;
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = digits[i] - (multiply_high64(magic, digits[i]) >> shift) * d;
+        }
+    }
+}
+
+// Racha mínima para reduce_run: en rachas más cortas se reduce valor a valor con
+// remainder(), sin el salto de fórmula por racha que con bases mezcladas se predice mal
+constexpr std::size_t divider_min_run = 16;
+
+// Caché de correspondencia directa base -> divisor de reduce_digits: construir un divisor
+// cuesta dos divisiones, así que cada base lo construye una vez y lo reutiliza en todas
+// sus rachas mientras no la desplace otra base del mismo hueco. Dos huecos por valor,
+// entre 2^4 y 2^9, en la pila; solo se inicializa la base de los huecos que se usan.
+constexpr unsigned reduce_digits_slot_bits = 9;
+
+struct DividerSlot {
+    std::uint64_t base;  // 0: libre
+    union {
+        FastDivider divider;  // Sin construir hasta que el hueco recibe una base
+    };
+
+    DividerSlot() noexcept {}
+};
+
+inline unsigned reduce_digits_bits(std::size_t count) noexcept {
+    unsigned bits = 4;
+    while (bits < reduce_digits_slot_bits && (std::size_t(1) << bits) < 2 * count) {
+        bits++;
+    }
+    return bits;
+}
+
+// digits[i] % bases[i] para count literales ya parseados (bases de 1 a 2^32, o 0 en las
+// filas con error, que dan 0), solo con multiplicaciones. En los flujos reales la base se
+// repite en rachas: las largas van a reduce_run y las cortas, valor a valor, con el mismo
+// divisor de la caché.
+inline void reduce_digits(const std::uint64_t* const digits, const std::uint64_t* const bases, std::uint64_t* const out,
+                          std::size_t count) noexcept {
+    DividerSlot slots[std::size_t(1) << reduce_digits_slot_bits];
+    const unsigned bits = reduce_digits_bits(count);
+    for (std::size_t s = 0; s < (std::size_t(1) << bits); ++s) {
+        slots[s].base = 0;
+    }
+    std::size_t i = 0;
+    while (i < count) {
+        const std::uint64_t base = bases[i];
+        std::size_t run_end = i + 1;
+        while (run_end < count && bases[run_end] == base) {
+            run_end++;
+        }
+        if (base == 0) {
+            for (std::size_t j = i; j < run_end; ++j) {
+                out[j] = 0;
+            }
+            i = run_end;
+            continue;
+        }
+        DividerSlot& slot = slots[(base * 0x9E3779B97F4A7C15ULL) >> (64 - bits)];
+        if (slot.base != base) {
+            slot.base = base;
+            slot.divider = FastDivider(base);
+        }
+        if (run_end - i < divider_min_run) {
+            for (std::size_t j = i; j < run_end; ++j) {
+                out[j] = slot.divider.remainder(digits[j]);
+            }
+        } else {
+            reduce_run(slot.divider, digits + i, out + i, run_end - i);
+        }
+        i = run_end;
+    }
+}
+
+// --- Reducción por lotes agrupada por base ---
+//
+// En un flujo de literales aparecen pocas decenas de bases distintas, pero mezcladas:
+// las rachas son cortas y reduce_digits reduce valor a valor. DigitReducer trabaja por
+// bloques de reduce_block literales: agrupa los de cada base (ordenación por conteo),
+// reduce cada grupo con el divisor de la caché y un núcleo vectorial, y devuelve los
+// restos a su posición de entrada. Agrupar y devolver cuesta varios ns por literal:
+// compensa donde la división de 64 bits es lenta (decenas de ciclos); con un divisor
+// hardware rápido el % directo puede salir mejor (ver xperiment_bench).
+
+// Caché base -> divisor. Cada base distinta recibe un índice denso en orden de llegada
+// (tabla hash de direccionamiento abierto, ocupación <= 1/4: casi siempre acierta a la
+// primera y el salto del sondeo se predice); su divisor se construye una sola vez y se
+// conserva entre llamadas.
+class DividerCache {
+public:
+    // Índice de `base` (1..2^32), construyendo su divisor la primera vez
+    std::uint32_t index_of(std::uint64_t base) {
+        const Slot& first = slots_[home_slot(base)];
+        return first.base == base ? first.index : probe(base);
+    }
+
+    const FastDivider& divider(std::uint32_t index) const noexcept { return dividers_[index]; }
+    std::size_t size() const noexcept { return dividers_.size(); }
+
+private:
+    struct Slot {
+        std::uint64_t base;  // 0: libre
+        std::uint32_t index;
+    };
+
+    std::size_t home_slot(std::uint64_t base) const noexcept {
+        return static_cast<std::size_t>((base * 0x9E3779B97F4A7C15ULL) >> 32) & (slots_.size() - 1);
+    }
+
+    // Sondeo lineal tras fallar el primer hueco; inserta la base si no está
+    std::uint32_t probe(std::uint64_t base) {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t slot = home_slot(base);
+        while (slots_[slot].base != 0) {
+            if (slots_[slot].base == base) {
+                return slots_[slot].index;
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (4 * (dividers_.size() + 1) > slots_.size()) {
+            grow();
+            return probe(base);
+        }
+        const std::uint32_t index = static_cast<std::uint32_t>(dividers_.size());
+        slots_[slot] = Slot{base, index};
+        dividers_.emplace_back(base);
+        return index;
+    }
+
+    void grow() {
+        std::vector<Slot> old(2 * slots_.size(), Slot{0, 0});
+        old.swap(slots_);
+        const std::size_t mask = slots_.size() - 1;
+        for (const Slot& entry : old) {
+            if (entry.base == 0) {
+                continue;
+            }
+            std::size_t slot = home_slot(entry.base);
+            while (slots_[slot].base != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = entry;
+        }
+    }
+
+    std::vector<Slot> slots_ = std::vector<Slot>(256, Slot{0, 0});
+    std::vector<FastDivider> dividers_;
+};
+
+#if XPERIMENT_X86
+
+// reduce_run con 4 valores por instrucción. AVX2 no tiene mulhi de 64 bits: se arma con
+// cuatro productos de 32 x 32 bits (vpmuludq), y q * d con dos más (d < 2^32 salvo en
+// potencias de dos, que son una máscara).
+template<bool Add>
+XPERIMENT_TARGET("avx2")
+inline std::size_t reduce_run_avx2_body(const FastDivider& divider, const std::uint64_t* const digits, std::uint64_t* const out,
+                                        std::size_t n) noexcept {
+    const __m256i magic_low = _mm256_set1_epi64x(static_cast<long long>(divider.magic & 0xFFFFFFFFu));
+    const __m256i magic_high = _mm256_set1_epi64x(static_cast<long long>(divider.magic >> 32));
+    const __m256i d = _mm256_set1_epi64x(static_cast<long long>(divider.divisor));
+    const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(divider.shift));
+    const __m128i add_shift = _mm_cvtsi32_si128(static_cast<int>(divider.add_shift));
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + i));
+        const __m256i x_high = _mm256_srli_epi64(x, 32);
+        const __m256i low_low = _mm256_mul_epu32(x, magic_low);
+        const __m256i t = _mm256_add_epi64(_mm256_mul_epu32(x_high, magic_low), _mm256_srli_epi64(low_low, 32));
+        const __m256i u = _mm256_add_epi64(_mm256_mul_epu32(x, magic_high), _mm256_and_si256(t, low32));
+        __m256i q = _mm256_add_epi64(_mm256_mul_epu32(x_high, magic_high),
+                                     _mm256_add_epi64(_mm256_srli_epi64(t, 32), _mm256_srli_epi64(u, 32)));
+        if (Add) {
+            q = _mm256_add_epi64(q, _mm256_srl_epi64(_mm256_sub_epi64(x, q), add_shift));
+        }
+        q = _mm256_srl_epi64(q, shift);
+        const __m256i product = _mm256_add_epi64(_mm256_mul_epu32(q, d),
+                                                 _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(q, 32), d), 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_sub_epi64(x, product));
+    }
+    return i;
+}
+
+XPERIMENT_TARGET("avx2")
+inline void reduce_run_avx2(const FastDivider& divider, const std::uint64_t* const digits, std::uint64_t* const out,
+                            std::size_t n) noexcept {
+    std::size_t i = 0;
+    if (divider.magic == 0) {
+        const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(divider.divisor - 1));
+        for (; i + 4 <= n; i += 4) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_and_si256(x, mask));
+        }
+    } else {
+        i = divider.add ? reduce_run_avx2_body<true>(divider, digits, out, n) : reduce_run_avx2_body<false>(divider, digits, out, n);
+    }
+    reduce_run(divider, digits + i, out + i, n - i);
+}
+
+#endif // XPERIMENT_X86
+
+using ReduceRunKernel = void (*)(const FastDivider&, const std::uint64_t*, std::uint64_t*, std::size_t);
+
+inline ReduceRunKernel select_reduce_run_kernel(SimdLevel level) noexcept {
+#if XPERIMENT_X86
+    if (level == SimdLevel::Avx2) {
+        return &reduce_run_avx2;
+    }
+#else
+    (void)level;
+#endif
+    return &reduce_run;
+}
+
+constexpr std::size_t reduce_block = 4096;
+
+// Reductor reutilizable: la caché de divisores y los buffers de agrupación se conservan
+// entre llamadas. No es seguro usar el mismo objeto desde varios hilos a la vez.
+class DigitReducer {
+public:
+    DigitReducer()
+        : kernel_(select_reduce_run_kernel(simd_level())),
+          buckets_(reduce_block), grouped_(reduce_block), order_(reduce_block) {}
+
+    // Como reduce_digits: out[i] = digits[i] % bases[i], 0 si bases[i] es 0
+    void reduce(const std::uint64_t* const digits, const std::uint64_t* const bases, std::uint64_t* const out,
+                std::size_t count) {
+        for (std::size_t first = 0; first < count; first += reduce_block) {
+            reduce_block_of(digits + first, bases + first, out + first, std::min(reduce_block, count - first));
+        }
+    }
+
+    const DividerCache& cache() const noexcept { return cache_; }
+
+private:
+    static constexpr std::uint32_t no_bucket = 0xFFFFFFFFu;
+
+    void reduce_block_of(const std::uint64_t* const digits, const std::uint64_t* const bases, std::uint64_t* const out,
+                         std::size_t n) {
+        // Cubeta de cada literal y tamaño de cada cubeta; las rachas se saltan la caché
+        std::uint64_t last_base = 0;
+        std::uint32_t last_bucket = no_bucket;
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::uint64_t base = bases[k];
+            if (base == 0) {
+                buckets_[k] = no_bucket;
+                out[k] = 0;
+                continue;
+            }
+            if (base != last_base) {
+                last_base = base;
+                last_bucket = cache_.index_of(base);
+                if (last_bucket >= sizes_.size()) {
+                    sizes_.resize(cache_.size(), 0);
+                }
+            }
+            buckets_[k] = last_bucket;
+            if (sizes_[last_bucket]++ == 0) {
+                used_.push_back(last_bucket);
+            }
+        }
+
+        // Tamaños -> posiciones de escritura; al agrupar quedan en el final de cada cubeta
+        std::uint32_t offset = 0;
+        for (const std::uint32_t bucket : used_) {
+            const std::uint32_t size = sizes_[bucket];
+            sizes_[bucket] = offset;
+            offset += size;
+        }
+        for (std::size_t k = 0; k < n; ++k) {
+            if (buckets_[k] != no_bucket) {
+                const std::uint32_t position = sizes_[buckets_[k]]++;
+                grouped_[position] = digits[k];
+                order_[position] = static_cast<std::uint16_t>(k);
+            }
+        }
+
+        std::uint32_t start = 0;
+        for (const std::uint32_t bucket : used_) {
+            const std::uint32_t end = sizes_[bucket];
+            kernel_(cache_.divider(bucket), grouped_.data() + start, grouped_.data() + start, end - start);
+            sizes_[bucket] = 0;
+            start = end;
+        }
+        used_.clear();
+
+        for (std::uint32_t position = 0; position < start; ++position) {
+            out[order_[position]] = grouped_[position];
+        }
+    }
+
+    ReduceRunKernel kernel_;
+    DividerCache cache_;
+    std::vector<std::uint32_t> buckets_;  // Cubeta de cada literal del bloque
+    std::vector<std::uint64_t> grouped_;  // Dígitos agrupados por cubeta, reducidos en su sitio
+    std::vector<std::uint16_t> order_;    // Posición de entrada de cada dígito agrupado
+    std::vector<std::uint32_t> sizes_;    // Por cubeta: tamaño, luego posición de escritura
+    std::vector<std::uint32_t> used_;     // Cubetas con literales en el bloque, en orden de llegada
+};
+
+#endif // DIVIDER_HPP
@@ -0,0 +1,1027 @@
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "expected_cpp14.hpp"
+#include "ParseError.hpp"
+#include "ParseBatch.hpp"
+#include "ParseColumns.hpp"
+#include "ParseIngest.hpp"
+#include "ParsePool.hpp"
+#include "ParseReader.hpp"
+#include "ParseFloat.hpp"
+#include "ParseRadix.hpp"
+#include "ParseSeparator.hpp"
+#include "ParseSimd.hpp"
+#include "ParseStructural.hpp"
+#include "ParseValidate.hpp"
+#include "digits.hpp"
+#include "divider.hpp"
+
+// std::from_chars (C++17) como referencia cuando el compilador lo tiene; CMake compila
+// este ejecutable en C++17 si está disponible
+#if defined(_MSVC_LANG) && _MSVC_LANG > __cplusplus
+#define XPERIMENT_BENCH_CPLUSPLUS _MSVC_LANG
+#else
+#define XPERIMENT_BENCH_CPLUSPLUS __cplusplus
+#endif
+#if XPERIMENT_BENCH_CPLUSPLUS >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#define XPERIMENT_BENCH_FROM_CHARS 1
+#endif
+#endif
+#ifndef XPERIMENT_BENCH_FROM_CHARS
+#define XPERIMENT_BENCH_FROM_CHARS 0
+#endif
+
+// Contador de ciclos del procesador (TSC en x86: ciclos a frecuencia nominal); en otras
+// arquitecturas no hay contador portable y la columna cycles/B sale vacía
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define XPERIMENT_BENCH_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define XPERIMENT_BENCH_TSC 1
+#else
+#define XPERIMENT_BENCH_TSC 0
+#endif
+
+// Micro-benchmark de los caminos de parseo. Cada medida es el mejor de varias pasadas
+// sobre el mismo buffer para quitar ruido de arranque y de caché fría.
+
+namespace {
+
+const int repetitions = 7;
+const std::size_t record_count = 4000000;
+
+inline std::uint64_t read_cycle_counter() noexcept {
+#if XPERIMENT_BENCH_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct Timing {
+    double seconds;
+    std::uint64_t cycles;  // 0 si no hay contador de ciclos
+};
+
+template<typename F>
+Timing best_of(F&& run) {
+    Timing best{1e30, 0};
+    for (int i = 0; i < repetitions; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t start_cycles = read_cycle_counter();
+        run();
+        const std::uint64_t cycles = read_cycle_counter() - start_cycles;
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best.seconds) {
+            best = Timing{elapsed.count(), cycles};
+        }
+    }
+    return best;
+}
+
+void report(const char* name, const Timing& timing, std::size_t values, std::size_t bytes, std::uint64_t checksum) {
+    char cycles_per_byte[16] = "     n/a";
+    if (timing.cycles != 0) {
+        std::snprintf(cycles_per_byte, sizeof(cycles_per_byte), "%8.2f", static_cast<double>(timing.cycles) / static_cast<double>(bytes));
+    }
+    std::printf("%-28s %8.2f ns/value %s cycles/B %8.2f GB/s   (checksum %llu)\n", name,
+                timing.seconds * 1e9 / static_cast<double>(values), cycles_per_byte,
+                static_cast<double>(bytes) / timing.seconds / 1e9,
+                static_cast<unsigned long long>(checksum));
+}
+
+// Números uniformes en todo el rango de uint64_t, uno por línea
+std::string make_uniform_lines(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::string text;
+    text.reserve(count * 21);
+    for (std::size_t i = 0; i < count; ++i) {
+        text += std::to_string(rng());
+        text += '\n';
+    }
+    return text;
+}
+
+void bench_lines(const std::string& text) {
+    const char* const first = text.data();
+    const char* const last = first + text.size();
+    const std::size_t lines = count_lines(first, last);
+    std::vector<std::uint64_t> out(lines);
+    std::vector<LineError> errors;
+
+    std::uint64_t checksum = 0;
+    const Timing batch = best_of([&] {
+        errors.clear();
+        parse_number_lines(first, last, out.data(), out.size(), errors);
+        checksum = out[lines / 2] + errors.size();
+    });
+    report("parse_number_lines", batch, lines, text.size(), checksum);
+
+    // Referencia: una llamada por línea, buscando el '\n' con memchr
+    const Timing per_line = best_of([&] {
+        std::size_t count = 0;
+        const char* line = first;
+        while (line != last) {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(last - line)));
+            if (newline == nullptr) {
+                newline = last;
+            }
+            const Expected<std::uint64_t, ParseError> value = parse_number_field(line, newline);
+            out[count++] = value ? *value : 0;
+            line = newline == last ? last : newline + 1;
+        }
+        checksum = out[lines / 2];
+    });
+    report("per-line parse_number_field", per_line, lines, text.size(), checksum);
+}
+
+// Bucle dígito a dígito con división y resta por dígito (versión anterior de
+// parse_number_simple), como referencia para la detección de overflow por longitud
+std::uint64_t parse_number_per_digit_checks(const char* const str, int& end_index, bool& ok) {
+    const std::uint64_t max_uint64 = 18446744073709551615ULL;
+    std::uint64_t result = 0;
+    int index = 0;
+    ok = true;
+    while (str[index] >= '0' && str[index] <= '9') {
+        const std::uint64_t digit = static_cast<std::uint64_t>(str[index] - '0');
+        if (result > max_uint64 / 10 || result * 10 > max_uint64 - digit) {
+            ok = false;
+            break;
+        }
+        result = result * 10 + digit;
+        index++;
+    }
+    end_index = index;
+    return result;
+}
+
+// Número aleatorio con exactamente `digits` dígitos (1..20) que cabe en un uint64_t
+std::uint64_t random_with_digits(std::mt19937_64& rng, int digits) {
+    if (digits >= 20) {
+        const std::uint64_t low = 10000000000000000000ULL;
+        return low + rng() % (18446744073709551615ULL - low + 1);
+    }
+    const std::uint64_t low = power_of_ten(digits - 1);
+    return low + rng() % (power_of_ten(digits) - low);
+}
+
+// Números terminados en '\0' uno tras otro; `starts` guarda el inicio de cada uno
+struct NulTerminatedInput {
+    std::string text;
+    std::vector<std::size_t> starts;
+};
+
+template<typename DigitCount>
+NulTerminatedInput make_nul_terminated(std::size_t count, DigitCount&& digit_count) {
+    std::mt19937_64 rng(7);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        input.text += std::to_string(random_with_digits(rng, digit_count(rng)));
+        input.text += '\0';
+    }
+    return input;
+}
+
+// Referencias de la biblioteca estándar sobre las mismas entradas. Los valores que no
+// caben (strtoull: ERANGE, from_chars: result_out_of_range) cuentan como 0, como en los
+// parsers propios
+void bench_library_parsers(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    const Timing reference = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            char* end = nullptr;
+            errno = 0;
+            const unsigned long long value = std::strtoull(text + start, &end, 10);
+            sum += (errno == 0 && end != text + start) ? value : 0;
+        }
+        checksum = sum;
+    });
+    report("strtoull", reference, count, input.text.size(), checksum);
+
+#if XPERIMENT_BENCH_FROM_CHARS
+    const char* const text_last = text + input.text.size();
+    const Timing standard = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            std::uint64_t value = 0;
+            const std::from_chars_result result = std::from_chars(text + start, text_last, value);
+            sum += result.ec == std::errc() ? value : 0;
+        }
+        checksum = sum;
+    });
+    report("std::from_chars", standard, count, input.text.size(), checksum);
+#endif
+}
+
+void bench_length_distribution(const char* title, const NulTerminatedInput& input) {
+    std::printf("--- %s ---\n", title);
+    const char* const text = input.text.data();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    const Timing per_digit = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            int end = 0;
+            bool ok = false;
+            const std::uint64_t value = parse_number_per_digit_checks(text + start, end, ok);
+            sum += ok ? value : 0;
+        }
+        checksum = sum;
+    });
+    report("per-digit overflow checks", per_digit, count, input.text.size(), checksum);
+
+    const Timing by_length = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number_simple(text + start, 0, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number_simple", by_length, count, input.text.size(), checksum);
+
+    const Timing vectorized = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number_fast(text + start, 0, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number_fast", vectorized, count, input.text.size(), checksum);
+
+    // Solo sintaxis: el checksum es el número de campos válidos
+    const Timing validation = best_of([&] {
+        std::uint64_t valid = 0;
+        for (const std::size_t start : input.starts) {
+            valid += validate_number(text + start) ? 1 : 0;
+        }
+        checksum = valid;
+    });
+    report("validate_number", validation, count, input.text.size(), checksum);
+
+    bench_library_parsers(input);
+}
+
+// Entradas con muchos errores: 40% números válidos, 20% que desbordan (21 a 24 dígitos),
+// 20% con basura detrás del número ("123a45") y 20% sin ningún dígito inicial. Los
+// parsers de prefijo (parse_number_simple, parse_number_fast, strtoull, from_chars) se
+// paran en la 'a' y devuelven 123: para ellos falla el 40%; solo validate_number, que
+// exige el campo completo, rechaza también la basura (60%).
+NulTerminatedInput make_error_heavy(std::size_t count) {
+    std::mt19937_64 rng(19);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        const int kind = static_cast<int>(rng() % 5);
+        if (kind <= 1) {
+            input.text += std::to_string(random_with_digits(rng, 1 + static_cast<int>(rng() % 20)));
+        } else if (kind == 2) {
+            input.text += std::to_string(random_with_digits(rng, 20));
+            input.text.append(1 + rng() % 4, static_cast<char>('0' + rng() % 10));
+        } else if (kind == 3) {
+            input.text += std::to_string(random_with_digits(rng, 1 + static_cast<int>(rng() % 10)));
+            input.text += "a45";
+        } else {
+            input.text += (rng() % 2 != 0) ? "x12" : "";
+        }
+        input.text += '\0';
+    }
+    return input;
+}
+
+// Literales de dígito con sus variantes ("d#N#BM", "dig[N]BM", con blancos) y un 10% de
+// literales erróneos, terminados en '\0'
+NulTerminatedInput make_digit_literals(std::size_t count) {
+    std::mt19937_64 rng(23);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char literal[80];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        const unsigned long long digit = random_with_digits(rng, 1 + static_cast<int>(rng() % 12));
+        const unsigned long long base = 2 + rng() % 1000;
+        switch (rng() % 10) {
+        case 0:
+            std::snprintf(literal, sizeof(literal), "d#%llu]B%llu", digit, base);
+            break;
+        case 1:
+        case 2:
+            std::snprintf(literal, sizeof(literal), "dig[%llu]B%llu", digit, base);
+            break;
+        case 3:
+            std::snprintf(literal, sizeof(literal), "d  #  %llu  #  B  %llu  ", digit, base);
+            break;
+        default:
+            std::snprintf(literal, sizeof(literal), "d#%llu#B%llu", digit, base);
+            break;
+        }
+        input.text += literal;
+        input.text += '\0';
+    }
+    return input;
+}
+
+// Tráfico real: casi todo canónico "d#N#BM" sin blancos, con un 2% en otras formas
+NulTerminatedInput make_canonical_digit_literals(std::size_t count) {
+    std::mt19937_64 rng(29);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char literal[80];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        const unsigned long long digit = random_with_digits(rng, 1 + static_cast<int>(rng() % 19));
+        const unsigned long long base = 2 + rng() % 100000;
+        if (rng() % 50 == 0) {
+            std::snprintf(literal, sizeof(literal), "dig [ %llu ] B %llu", digit, base);
+        } else {
+            std::snprintf(literal, sizeof(literal), "d#%llu#B%llu", digit, base);
+        }
+        input.text += literal;
+        input.text += '\0';
+    }
+    return input;
+}
+
+// Todos con blancos entre los elementos: la etapa 2 del parser indexado salta de
+// elemento en elemento en lugar de resolver el literal con una lectura por bitmap
+NulTerminatedInput make_padded_digit_literals(std::size_t count) {
+    std::mt19937_64 rng(41);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char literal[80];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        const unsigned long long digit = random_with_digits(rng, 1 + static_cast<int>(rng() % 19));
+        const unsigned long long base = 2 + rng() % 100000;
+        if (rng() % 2 == 0) {
+            std::snprintf(literal, sizeof(literal), "d  #  %llu  #  B  %llu  ", digit, base);
+        } else {
+            std::snprintf(literal, sizeof(literal), "dig [ %llu ] B %llu", digit, base);
+        }
+        input.text += literal;
+        input.text += '\0';
+    }
+    return input;
+}
+
+void bench_digit_literals(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    const Timing nul_terminated = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            const Expected<DigitResult, ParseError> literal = parse_digit_format_simple(text + start);
+            sum += literal ? literal->digit + literal->base : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_digit_format_simple", nul_terminated, count, input.text.size(), checksum);
+
+    // Versión acotada: la longitud de cada literal se conoce por el inicio del siguiente
+    const Timing bounded = best_of([&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* const first = text + input.starts[i];
+            const char* const last = text + (i + 1 < count ? input.starts[i + 1] : input.text.size()) - 1;
+            const Expected<DigitResult, ParseError> literal = parse_digit_format_field(first, last);
+            sum += literal ? literal->digit + literal->base : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_digit_format_field", bounded, count, input.text.size(), checksum);
+
+    const Timing validation = best_of([&] {
+        std::uint64_t valid = 0;
+        for (const std::size_t start : input.starts) {
+            valid += validate_digit_format(text + start) ? 1 : 0;
+        }
+        checksum = valid;
+    });
+    report("validate_digit_format", validation, count, input.text.size(), checksum);
+
+    // Los mismos literales uno por línea: máquina de estados por línea frente a las dos etapas
+    std::string lines = input.text;
+    for (char& c : lines) {
+        c = c == '\0' ? '\n' : c;
+    }
+    std::vector<std::uint64_t> digits(count);
+    std::vector<std::uint64_t> bases(count);
+    std::vector<LineError> errors;
+    const Timing per_line = best_of([&] {
+        errors.clear();
+        parse_digit_lines(lines.data(), lines.data() + lines.size(), digits.data(), bases.data(), count, errors);
+        checksum = digits[count / 2] + bases[count / 2] + errors.size();
+    });
+    report("parse_digit_lines", per_line, count, lines.size(), checksum);
+
+    const Timing indexed = best_of([&] {
+        errors.clear();
+        parse_digit_lines_indexed(lines.data(), lines.data() + lines.size(), digits.data(), bases.data(), count, errors);
+        checksum = digits[count / 2] + bases[count / 2] + errors.size();
+    });
+    report("parse_digit_lines_indexed", indexed, count, lines.size(), checksum);
+}
+
+// Pares (dígito, base) ya parseados: 40 bases distintas que llegan en rachas de 1 a
+// max_run literales
+struct DigitBasePairs {
+    std::vector<std::uint64_t> digits;
+    std::vector<std::uint64_t> bases;
+};
+
+DigitBasePairs make_digit_base_pairs(std::size_t count, std::size_t max_run) {
+    std::mt19937_64 rng(31);
+    std::uint64_t distinct[40];
+    for (std::uint64_t& base : distinct) {
+        base = 2 + rng() % 100000;
+    }
+    DigitBasePairs pairs;
+    pairs.digits.reserve(count);
+    pairs.bases.reserve(count);
+    while (pairs.digits.size() < count) {
+        const std::uint64_t base = distinct[rng() % 40];
+        for (std::size_t run = 1 + rng() % max_run; run != 0 && pairs.digits.size() < count; --run) {
+            pairs.digits.push_back(random_with_digits(rng, 1 + static_cast<int>(rng() % 19)));
+            pairs.bases.push_back(base);
+        }
+    }
+    return pairs;
+}
+
+// El 90% de las rachas en las bases de HotBaseDispatcher, el resto en bases cualesquiera
+DigitBasePairs make_hot_base_pairs(std::size_t count, std::size_t max_run) {
+    static const std::uint64_t hot[] = {2, 3, 7, 8, 10, 16, 256, 1000000000};
+    std::mt19937_64 rng(37);
+    DigitBasePairs pairs;
+    pairs.digits.reserve(count);
+    pairs.bases.reserve(count);
+    while (pairs.digits.size() < count) {
+        const std::uint64_t base = rng() % 10 != 0 ? hot[rng() % 8] : 2 + rng() % 100000;
+        for (std::size_t run = 1 + rng() % max_run; run != 0 && pairs.digits.size() < count; --run) {
+            pairs.digits.push_back(random_with_digits(rng, 1 + static_cast<int>(rng() % 19)));
+            pairs.bases.push_back(base);
+        }
+    }
+    return pairs;
+}
+
+void bench_digit_reduction(const DigitBasePairs& pairs) {
+    const std::size_t count = pairs.digits.size();
+    const std::size_t bytes = count * 2 * sizeof(std::uint64_t);
+    std::vector<std::uint64_t> results(count);
+
+    const Timing hardware = best_of([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            results[i] = pairs.digits[i] % pairs.bases[i];
+        }
+    });
+    report("digit % base (div)", hardware, count, bytes, results[count / 2]);
+
+    const Timing divider = best_of([&] {
+        reduce_digits(pairs.digits.data(), pairs.bases.data(), results.data(), count);
+    });
+    report("reduce_digits", divider, count, bytes, results[count / 2]);
+
+    DigitReducer reducer;
+    const Timing bucketed = best_of([&] {
+        reducer.reduce(pairs.digits.data(), pairs.bases.data(), results.data(), count);
+    });
+    report("DigitReducer (bucketed)", bucketed, count, bytes, results[count / 2]);
+
+    HotBaseDispatcher dispatcher;
+    const Timing dispatched = best_of([&] {
+        dispatcher.reduce(pairs.digits.data(), pairs.bases.data(), results.data(), count);
+    });
+    report("HotBaseDispatcher", dispatched, count, bytes, results[count / 2]);
+}
+
+// Hash polinómico h = h * 31 + v módulo un primo, como en nuestros checksums: % con el
+// módulo en ejecución frente a digit<P>, que reduce sin dividir
+template<std::uint64_t P>
+void bench_digit_checksum(const std::vector<std::uint64_t>& values) {
+    const std::size_t count = values.size();
+    const std::size_t bytes = count * sizeof(std::uint64_t);
+    volatile std::uint64_t runtime_modulus = P;
+    const std::uint64_t modulus = runtime_modulus;
+    std::uint64_t checksum = 0;
+
+    const Timing hardware = best_of([&] {
+        std::uint64_t h = 0;
+        for (const std::uint64_t v : values) {
+            h = (h * 31 + v % modulus) % modulus;
+        }
+        checksum = h;
+    });
+    report("% (runtime modulus)", hardware, count, bytes, checksum);
+
+    const Timing residues = best_of([&] {
+        digit<P> h(0);
+        const digit<P> multiplier(31);
+        for (const std::uint64_t v : values) {
+            h = h * multiplier + digit<P>(v);
+        }
+        checksum = h.value;
+    });
+    report("digit<P> arithmetic", residues, count, bytes, checksum);
+}
+
+// Números uniformes en longitud con '_' cada tres cifras ("18_446_744"), terminados en '\0'
+NulTerminatedInput make_grouped_numbers(std::size_t count) {
+    std::mt19937_64 rng(29);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        const std::string digits = std::to_string(random_with_digits(rng, 1 + static_cast<int>(rng() % 20)));
+        for (std::size_t k = 0; k < digits.size(); ++k) {
+            if (k != 0 && (digits.size() - k) % 3 == 0) {
+                input.text += '_';
+            }
+            input.text += digits[k];
+        }
+        input.text += '\0';
+    }
+    return input;
+}
+
+void bench_grouped_numbers(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    // Referencia: copia sin separadores y parse_number_simple sobre la copia
+    const Timing copy = best_of([&] {
+        std::uint64_t sum = 0;
+        std::string clean;
+        for (const std::size_t start : input.starts) {
+            clean.clear();
+            for (const char* p = text + start; *p != '\0'; ++p) {
+                if (*p != '_') {
+                    clean += *p;
+                }
+            }
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number_simple(clean.c_str(), 0, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("strip copy + parse", copy, count, input.text.size(), checksum);
+
+    const Timing scalar = best_of([&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* const last = text + (i + 1 < count ? input.starts[i + 1] : input.text.size()) - 1;
+            const char* end = nullptr;
+            const Expected<std::uint64_t, ParseError> value = parse_number_separated_simple<'_'>(text + input.starts[i], last, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number_separated_simple", scalar, count, input.text.size(), checksum);
+
+    const Timing vectorized = best_of([&] {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* const last = text + (i + 1 < count ? input.starts[i + 1] : input.text.size()) - 1;
+            const char* end = nullptr;
+            const Expected<std::uint64_t, ParseError> value = parse_number_separated<'_'>(text + input.starts[i], last, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number_separated", vectorized, count, input.text.size(), checksum);
+}
+
+// Identificadores hexadecimales de 64 bits ("%llx"), terminados en '\0'
+NulTerminatedInput make_hex_ids(std::size_t count) {
+    std::mt19937_64 rng(11);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char id[24];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        std::snprintf(id, sizeof(id), "%llx", static_cast<unsigned long long>(rng()));
+        input.text += id;
+        input.text += '\0';
+    }
+    return input;
+}
+
+void bench_hex_ids(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const char* const text_last = text + input.text.size();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    const Timing reference = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            sum += std::strtoull(text + start, nullptr, 16);
+        }
+        checksum = sum;
+    });
+    report("strtoull(16)", reference, count, input.text.size(), checksum);
+
+    const Timing scalar = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number<16>(text + start, 0, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number<16> ('\\0')", scalar, count, input.text.size(), checksum);
+
+    // La versión acotada puede cargar 8 bytes a la vez porque conoce el final del buffer
+    const Timing bounded = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            const char* end = nullptr;
+            const Expected<std::uint64_t, ParseError> value = parse_number<16>(text + start, text_last, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_number<16> (bounded)", bounded, count, input.text.size(), checksum);
+}
+
+// Doubles aleatorios en todo el rango, impresos con 17 cifras significativas
+NulTerminatedInput make_doubles(std::size_t count) {
+    std::mt19937_64 rng(13);
+    std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+    std::uniform_int_distribution<int> exponent(-300, 300);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char text[40];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        std::snprintf(text, sizeof(text), "%.17g", mantissa(rng) * std::pow(10.0, exponent(rng)));
+        input.text += text;
+        input.text += '\0';
+    }
+    return input;
+}
+
+void bench_doubles(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const char* const text_last = text + input.text.size();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    // Suma de las representaciones binarias: iguales solo si todos los redondeos coinciden
+    const auto bits_of = [](double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    };
+
+    const Timing reference = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            sum += bits_of(std::strtod(text + start, nullptr));
+        }
+        checksum = sum;
+    });
+    report("strtod", reference, count, input.text.size(), checksum);
+
+    const Timing fast = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            const char* end = nullptr;
+            const Expected<double, ParseError> value = parse_double(text + start, text_last, end);
+            sum += value ? bits_of(*value) : 0;
+        }
+        checksum = sum;
+    });
+    report("parse_double", fast, count, input.text.size(), checksum);
+}
+
+// Campos alineados a la derecha en columnas de 64 bytes, terminados en '\0'
+NulTerminatedInput make_padded_fields(std::size_t count) {
+    std::mt19937_64 rng(17);
+    NulTerminatedInput input;
+    input.starts.reserve(count);
+    char field[72];
+    for (std::size_t i = 0; i < count; ++i) {
+        input.starts.push_back(input.text.size());
+        std::snprintf(field, sizeof(field), "%63llu", static_cast<unsigned long long>(rng() % 1000000));
+        input.text += field;
+        input.text += '\0';
+    }
+    return input;
+}
+
+void bench_padded_fields(const NulTerminatedInput& input) {
+    const char* const text = input.text.data();
+    const std::size_t count = input.starts.size();
+    std::uint64_t checksum = 0;
+
+    // Referencia: la cadena de cuatro comparaciones que usaba skip_whitespace
+    const Timing compare_chain = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            const char* p = text + start;
+            while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+                p++;
+            }
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number_simple(p, 0, end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("compare-chain skip", compare_chain, count, input.text.size(), checksum);
+
+    const Timing table = best_of([&] {
+        std::uint64_t sum = 0;
+        for (const std::size_t start : input.starts) {
+            int end = 0;
+            const Expected<std::uint64_t, ParseError> value = parse_number_simple(text + start, skip_whitespace(text + start, 0), end);
+            sum += value ? *value : 0;
+        }
+        checksum = sum;
+    });
+    report("skip_whitespace", table, count, input.text.size(), checksum);
+}
+
+// Filas CSV "a,b,c,d#N#BM": 3 columnas numéricas y una de literales
+std::string make_csv_rows(std::size_t count) {
+    std::mt19937_64 rng(42);
+    std::string text;
+    text.reserve(count * 48);
+    for (std::size_t i = 0; i < count; ++i) {
+        text += std::to_string(rng() % 100000);
+        text += ',';
+        text += std::to_string(rng() >> (rng() % 64));
+        text += ',';
+        text += std::to_string(rng() % 1000);
+        text += ",d#";
+        const std::uint64_t base = 2 + rng() % 1000;
+        text += std::to_string(rng() % base);
+        text += "#B";
+        text += std::to_string(base);
+        text += '\n';
+    }
+    return text;
+}
+
+void bench_csv_rows(const std::string& text) {
+    const char* const first = text.data();
+    const char* const last = first + text.size();
+    const std::size_t rows = count_lines(first, last);
+    std::vector<std::uint64_t> a(rows), b(rows), c(rows), digits(rows), bases(rows);
+    std::vector<std::uint64_t> errors(4 * error_bitmap_words(rows));
+    const std::size_t words = error_bitmap_words(rows);
+    const Column columns[] = {
+        {ColumnType::Number, a.data(), nullptr, errors.data()},
+        {ColumnType::Number, b.data(), nullptr, errors.data() + words},
+        {ColumnType::Number, c.data(), nullptr, errors.data() + 2 * words},
+        {ColumnType::DigitLiteral, digits.data(), bases.data(), errors.data() + 3 * words}};
+
+    std::uint64_t checksum = 0;
+    const Timing soa = best_of([&] {
+        parse_delimited_rows(first, last, ',', columns, 4, rows);
+        checksum = a[rows / 2] + b[rows / 2] + c[rows / 2] + digits[rows / 2] + bases[rows / 2] + errors[0];
+    });
+    report("parse_delimited_rows", soa, rows, text.size(), checksum);
+
+    // Referencia: memchr por campo a un array de structs y transposición a columnas
+    struct Row {
+        std::uint64_t a, b, c, digit, base;
+        bool ok;
+    };
+    std::vector<Row> aos(rows);
+    const Timing transposed = best_of([&] {
+        const char* line = first;
+        for (std::size_t r = 0; r < rows; ++r) {
+            const char* const newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(last - line)));
+            const char* const line_end = newline != nullptr ? newline : last;
+            std::uint64_t* const numbers[] = {&aos[r].a, &aos[r].b, &aos[r].c};
+            bool ok = true;
+            for (std::uint64_t* const out : numbers) {
+                const char* comma = static_cast<const char*>(std::memchr(line, ',', static_cast<std::size_t>(line_end - line)));
+                comma = comma != nullptr ? comma : line_end;
+                const Expected<std::uint64_t, ParseError> value = parse_number_field(line, comma);
+                *out = value ? *value : 0;
+                ok = ok && value.has_value();
+                line = comma != line_end ? comma + 1 : line_end;
+            }
+            const Expected<DigitResult, ParseError> literal = parse_digit_format_field(line, line_end);
+            aos[r].digit = literal ? literal->digit : 0;
+            aos[r].base = literal ? literal->base : 0;
+            aos[r].ok = ok && literal.has_value();
+            line = line_end != last ? line_end + 1 : last;
+        }
+        for (std::size_t r = 0; r < rows; ++r) {
+            a[r] = aos[r].a;
+            b[r] = aos[r].b;
+            c[r] = aos[r].c;
+            digits[r] = aos[r].digit;
+            bases[r] = aos[r].base;
+        }
+        checksum = a[rows / 2] + b[rows / 2] + c[rows / 2] + digits[rows / 2] + bases[rows / 2] + (aos[0].ok ? 0 : 1);
+    });
+    report("per-field AoS + transpose", transposed, rows, text.size(), checksum);
+}
+
+// Líneas con la primera cuarta parte cara: números rellenos de blancos y con errores
+std::string make_skewed_lines(std::size_t count) {
+    std::mt19937_64 rng(23);
+    std::string text;
+    text.reserve(count * 24);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i < count / 4) {
+            text.append(static_cast<std::size_t>(rng() % 40), ' ');
+            text += std::to_string(rng() >> (rng() % 64));
+            text += (rng() % 2 != 0) ? "x45" : "";
+            text.append(static_cast<std::size_t>(rng() % 40), ' ');
+        } else {
+            text += std::to_string(rng() >> (rng() % 64));
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+// Reparto estático (un trozo por hilo) frente al pool con robo de trabajo, en un buffer
+// grande y en lotes pequeños donde pesa crear los hilos
+void bench_pool(const char* title, const std::string& text) {
+    const char* const first = text.data();
+    const char* const last = first + text.size();
+    ParsePool pool;
+    std::uint64_t checksum = 0;
+    std::size_t lines = 0;
+    char name[64];
+
+    std::printf("%s\n", title);
+    const Timing fixed = best_of([&] {
+        const NumberIngestResult result = parse_number_lines_parallel(first, last, pool.size());
+        lines = result.values.size();
+        checksum = result.values[lines / 2] + result.errors.size();
+    });
+    std::snprintf(name, sizeof(name), "static split x%u", pool.size());
+    report(name, fixed, lines, text.size(), checksum);
+
+    const Timing stealing = best_of([&] {
+        const NumberIngestResult result = parse_number_lines_pooled(pool, first, last);
+        lines = result.values.size();
+        checksum = result.values[lines / 2] + result.errors.size();
+    });
+    std::snprintf(name, sizeof(name), "work-stealing pool x%u", pool.size());
+    report(name, stealing, lines, text.size(), checksum);
+
+    const std::vector<const char*> batches = split_at_lines(first, last, text.size() / (256 * 1024) + 1);
+    const Timing fixed_batches = best_of([&] {
+        checksum = 0;
+        for (std::size_t i = 0; i + 1 < batches.size(); ++i) {
+            checksum += parse_number_lines_parallel(batches[i], batches[i + 1], pool.size()).errors.size();
+        }
+    });
+    report("static split, 256 KiB batches", fixed_batches, lines, text.size(), checksum);
+
+    const Timing pooled_batches = best_of([&] {
+        checksum = 0;
+        for (std::size_t i = 0; i + 1 < batches.size(); ++i) {
+            checksum += parse_number_lines_pooled(pool, batches[i], batches[i + 1]).errors.size();
+        }
+    });
+    report("pool, 256 KiB batches", pooled_batches, lines, text.size(), checksum);
+}
+
+// Ingesta de fichero proyectado en memoria con 1 hilo y con todos los núcleos
+void bench_ingest(const std::string& text) {
+    const char* const path = "xperiment_bench_input.txt";
+    std::FILE* const file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        std::printf("cannot create %s, skipping ingest benchmark\n", path);
+        return;
+    }
+    std::fwrite(text.data(), 1, text.size(), file);
+    std::fclose(file);
+
+    std::vector<unsigned> thread_counts(1, 1u);
+    if (ingest_thread_count(0) > 1) {
+        thread_counts.push_back(ingest_thread_count(0));
+    }
+    std::uint64_t checksum = 0;
+    std::size_t lines = 0;
+    for (const unsigned threads : thread_counts) {
+        const Timing timing = best_of([&] {
+            const NumberIngestResult result = ingest_number_file(path, threads);
+            lines = result.values.size();
+            checksum = result.values[lines / 2] + result.errors.size();
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "ingest_number_file x%u", threads);
+        report(name, timing, lines, text.size(), checksum);
+    }
+
+    // Lectura por bloques solapada con el parseo, y la misma con pread (leer y parsear)
+    ReaderOptions options;
+    for (int uring = 1; uring >= 0; --uring) {
+        options.use_io_uring = uring != 0;
+        if (uring != 0 && !BlockReader(path, options).uses_io_uring()) {
+            continue;
+        }
+        const Timing timing = best_of([&] {
+            const NumberIngestResult result = read_number_file(path, options);
+            lines = result.values.size();
+            checksum = result.values[lines / 2] + result.errors.size();
+        });
+        report(uring != 0 ? "read_number_file (io_uring)" : "read_number_file (pread)", timing, lines, text.size(), checksum);
+    }
+    std::remove(path);
+}
+
+} // namespace
+
+int main() {
+    std::printf("=== Decimal uint64 by digit-length distribution (%zu values) ===\n", record_count);
+    bench_length_distribution("short-heavy (80% 1-4 digits, 20% 5-10)", make_nul_terminated(record_count, [](std::mt19937_64& rng) {
+        return rng() % 5 != 0 ? 1 + static_cast<int>(rng() % 4) : 5 + static_cast<int>(rng() % 6);
+    }));
+    bench_length_distribution("uniform length 1-20", make_nul_terminated(record_count, [](std::mt19937_64& rng) {
+        return 1 + static_cast<int>(rng() % 20);
+    }));
+    bench_length_distribution("max length (20 digits)", make_nul_terminated(record_count, [](std::mt19937_64&) {
+        return 20;
+    }));
+
+    bench_length_distribution("error-heavy (40% overflowing or no digits, 20% trailing junk)", make_error_heavy(record_count));
+
+    std::printf("\n=== Digit literals d#N#BM (%zu values) ===\n", record_count);
+    bench_digit_literals(make_digit_literals(record_count));
+
+    std::printf("\n=== Canonical digit literals, 98%% d#N#BM without whitespace (%zu values) ===\n", record_count);
+    bench_digit_literals(make_canonical_digit_literals(record_count));
+
+    std::printf("\n=== Blank-padded digit literals, blanks between every element (%zu values) ===\n", record_count);
+    bench_digit_literals(make_padded_digit_literals(record_count));
+
+    std::printf("\n=== Reducing parsed literals, digit %% base, 40 bases in runs of 1-64 (%zu values) ===\n", record_count);
+    bench_digit_reduction(make_digit_base_pairs(record_count, 64));
+
+    std::printf("\n=== Reducing parsed literals, digit %% base, 40 bases interleaved (%zu values) ===\n", record_count);
+    bench_digit_reduction(make_digit_base_pairs(record_count, 1));
+
+    std::printf("\n=== Reducing parsed literals, digit %% base, 90%% hot bases in runs of 1-64 (%zu values) ===\n", record_count);
+    bench_digit_reduction(make_hot_base_pairs(record_count, 64));
+
+    std::printf("\n=== Polynomial checksum mod 10^9 + 7 (%zu values) ===\n", record_count);
+    const DigitBasePairs checksum_input = make_digit_base_pairs(record_count, 1);
+    bench_digit_checksum<1000000007>(checksum_input.digits);
+
+    std::printf("\n=== Polynomial checksum mod 2^32 - 5 (%zu values) ===\n", record_count);
+    bench_digit_checksum<4294967291ULL>(checksum_input.digits);
+
+    std::printf("\n=== Grouped decimals 1_000_000 (%zu values) ===\n", record_count);
+    bench_grouped_numbers(make_grouped_numbers(record_count));
+
+    std::printf("\n=== Hexadecimal 64-bit ids (%zu values) ===\n", record_count);
+    bench_hex_ids(make_hex_ids(record_count));
+
+    std::printf("\n=== Decimal doubles, 17 significant digits (%zu values) ===\n", record_count);
+    bench_doubles(make_doubles(record_count));
+
+    std::printf("\n=== Right-aligned fields, 64-byte columns (%zu values) ===\n", record_count);
+    bench_padded_fields(make_padded_fields(record_count));
+
+    std::printf("\n=== Newline-delimited uint64 (%zu records) ===\n", record_count);
+    const std::string uniform = make_uniform_lines(record_count);
+    bench_lines(uniform);
+    bench_ingest(uniform);
+
+    std::printf("\n=== Parallel parsing, static split vs work-stealing pool (%zu records) ===\n", record_count);
+    bench_pool("uniform lines", uniform);
+    bench_pool("first quarter padded and error-heavy", make_skewed_lines(record_count));
+
+    std::printf("\n=== CSV rows a,b,c,d#N#BM into columns (%zu rows) ===\n", record_count);
+    bench_csv_rows(make_csv_rows(record_count));
+    return 0;
+}